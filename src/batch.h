@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "context.h"
+#include "groebner_basis.h"
+#include "thread_pool.h"
+
+namespace groebner_basis {
+
+// Indices [0, count) split into one contiguous range per lane. A lane takes indices from the
+// front of its own range, and when it is empty steals the back half of the longest other
+// range, so lanes that got cheap ideals help the others without a shared counter.
+class WorkStealingRanges {
+public:
+    WorkStealingRanges(size_t count, size_t lanes)
+        : ranges_(std::make_unique<Range[]>(lanes)), lanes_(lanes) {
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            ranges_[lane].begin = count * lane / lanes;
+            ranges_[lane].end = count * (lane + 1) / lanes;
+        }
+    }
+
+    std::optional<size_t> Next(size_t lane) {
+
+        while (true) {
+            {
+                Range &own = ranges_[lane];
+                std::lock_guard lock(own.mutex);
+                if (own.begin < own.end) {
+                    return own.begin++;
+                }
+            }
+
+            auto stolen = Steal(lane);
+            if (!stolen) {
+                return std::nullopt;
+            }
+            Range &own = ranges_[lane];
+            std::lock_guard lock(own.mutex);
+            own.begin = stolen->first;
+            own.end = stolen->second;
+        }
+    }
+
+private:
+    struct Range {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::optional<std::pair<size_t, size_t>> Steal(size_t thief) {
+
+        size_t victim = thief, longest = 0;
+        for (size_t lane = 0; lane < lanes_; ++lane) {
+            std::lock_guard lock(ranges_[lane].mutex);
+            size_t size = ranges_[lane].end - ranges_[lane].begin;
+            if (lane != thief && size > longest) {
+                victim = lane;
+                longest = size;
+            }
+        }
+        if (victim == thief) {
+            return std::nullopt;
+        }
+
+        // the victim may have moved on since it was chosen, then the search is repeated
+        Range &range = ranges_[victim];
+        std::lock_guard lock(range.mutex);
+        if (range.begin >= range.end) {
+            return std::make_pair(size_t(0), size_t(0));
+        }
+        size_t middle = range.begin + (range.end - range.begin) / 2;
+        std::pair<size_t, size_t> stolen = {middle, range.end};
+        range.end = middle;
+        return stolen;
+    }
+
+    std::unique_ptr<Range[]> ranges_;
+    size_t lanes_;
+};
+
+// Reduced Groebner bases of many independent ideals on a thread pool. Ideals are read from a
+// source in windows of window_size, every window is solved in parallel with work stealing
+// between the lanes, and the bases are handed out in input order on the calling thread. Every
+// lane has its own context and its own reduction workspace, which all ideals of the lane reuse,
+// and the window is kept between calls.
+template <typename Field, typename Order = GrevLexOrder>
+class BatchSolver {
+public:
+    using Set = PolynomialsSet<Field, Order>;
+    using Workspace = typename Set::Workspace;
+
+    explicit BatchSolver(ThreadPool &pool, size_t window_size = 1024)
+        : pool_(pool),
+          window_size_(std::max<size_t>(window_size, 1)),
+          contexts_(pool.Size()),
+          workspaces_(pool.Size()) {
+    }
+
+    // source() returns std::optional<Set> with std::nullopt after the last ideal, callback is
+    // called as callback(index, basis) with index counting the ideals from 0. Returns the
+    // number of ideals.
+    template <typename Source, typename Callback>
+    size_t Solve(Source &&source, Callback &&callback) {
+
+        size_t solved = 0;
+        while (true) {
+            window_.clear();
+            while (window_.size() < window_size_) {
+                auto ideal = source();
+                if (!ideal) {
+                    break;
+                }
+                window_.push_back(std::move(ideal.value()));
+            }
+            if (window_.empty()) {
+                return solved;
+            }
+
+            SolveWindow();
+            for (auto &basis : window_) {
+                callback(solved++, std::move(basis));
+            }
+        }
+    }
+
+    // Replaces every ideal by its reduced Groebner basis
+    void Solve(std::vector<Set> &ideals) {
+        std::swap(window_, ideals);
+        SolveWindow();
+        std::swap(window_, ideals);
+    }
+
+private:
+    void SolveWindow() {
+
+        size_t lanes = contexts_.size();
+        WorkStealingRanges ranges(window_.size(), lanes);
+
+        pool_.ParallelFor(lanes, [&](size_t lane, size_t) {
+            while (auto index = ranges.Next(lane)) {
+                Set &ideal = window_[index.value()];
+                Workspace *own = ideal.GetWorkspace();
+                ideal.SetWorkspace(&workspaces_[lane]);
+                ideal.BuildGreobnerBasis(contexts_[lane]);
+                ideal.SetWorkspace(own);
+            }
+        });
+    }
+
+    ThreadPool &pool_;
+    size_t window_size_;
+    std::vector<ComputationContext> contexts_;  // one per lane
+    std::vector<Workspace> workspaces_;          // one per lane
+    std::vector<Set> window_;
+};
+
+}  // namespace groebner_basis
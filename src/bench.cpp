@@ -1,8 +1,18 @@
 #include "groebner_basis.h"
+#include "batch.h"
+#include "boolean.h"
+#include "cache.h"
 #include <algorithm>
 #include <cstdint>
+#include <random>
 #include <vector>
 #include <benchmark/benchmark.h>
+#include <boost/rational.hpp>
+#include "evaluation.h"
+#include "kernels.h"
+#include "rational.h"
+#include "reducer.h"
+#include "stream.h"
 #include "types.h"
 
 namespace {
@@ -54,10 +64,616 @@ static void Cyclic(bm::State &state) {
     }
 }
 
+
+static void CyclicFullReduction(bm::State &state) {
+
+    size_t n = state.range(0);
+
+    auto s = BuildCyclic(n);
+    s.SetReductionMode(gb::ReductionMode::kFull);
+
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        bm::DoNotOptimize(temp);
+    }
+}
+
+static std::vector<gb::Polynom<ModInt>> BuildRandomBatch(size_t n, size_t count) {
+    std::mt19937 rng(239);
+    std::vector<gb::Polynom<ModInt>> batch;
+
+    for (size_t i = 0; i < count; ++i) {
+        gb::Polynom<ModInt>::Builder poly;
+        for (size_t j = 0; j < 8; ++j) {
+            std::vector<gb::Monom::Degree> degrees(n);
+            for (auto &degree : degrees) {
+                degree = rng() % 3;
+            }
+            poly = poly.AddTerm(static_cast<int>(rng() % 239),
+                                gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        batch.push_back(poly.BuildPolynom());
+    }
+
+    return batch;
+}
+
+static void NormalFormSequential(bm::State &state) {
+
+    auto basis = BuildCyclic(5);
+    basis.BuildGreobnerBasis();
+    auto batch = BuildRandomBatch(5, 64);
+
+    for (auto _ : state) {
+        for (const auto &f : batch) {
+            bm::DoNotOptimize(basis.Reduce(f));
+        }
+    }
+
+    state.counters["reductions/s"] =
+        bm::Counter(static_cast<double>(state.iterations() * batch.size()), bm::Counter::kIsRate);
+}
+
+static void NormalFormReducer(bm::State &state) {
+
+    auto basis = BuildCyclic(5);
+    basis.BuildGreobnerBasis();
+    auto batch = BuildRandomBatch(5, 64);
+
+    gb::Reducer<ModInt> reducer(basis);
+    gb::ThreadPool pool(state.range(0));
+
+    for (auto _ : state) {
+        bm::DoNotOptimize(reducer.NormalForms(batch, pool));
+    }
+
+    state.counters["reductions/s"] =
+        bm::Counter(static_cast<double>(state.iterations() * batch.size()), bm::Counter::kIsRate);
+}
+
+using WideModInt = gb::Modulus<std::int64_t, 998244353>;
+
+static constexpr uint32_t kPrime = 998244353;
+
+static std::vector<uint32_t> BuildRandomRow(size_t size, std::mt19937 &rng) {
+    std::vector<uint32_t> row(size);
+    for (auto &value : row) {
+        value = rng() % kPrime;
+    }
+    return row;
+}
+
+// y += c * x through Modulus, one % per coefficient
+static void AxpyModulus(bm::State &state) {
+    std::mt19937 rng(34);
+    auto x_row = BuildRandomRow(state.range(0), rng);
+    auto y_row = BuildRandomRow(state.range(0), rng);
+    std::vector<WideModInt> x(x_row.begin(), x_row.end()), y(y_row.begin(), y_row.end());
+    WideModInt c(rng() % kPrime);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < y.size(); ++i) {
+            y[i] += c * x[i];
+        }
+        bm::DoNotOptimize(y.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Simd>
+static void AxpyKernel(bm::State &state) {
+    std::mt19937 rng(34);
+    auto x = BuildRandomRow(state.range(0), rng);
+    auto y = BuildRandomRow(state.range(0), rng);
+    uint32_t c = rng() % kPrime;
+
+    for (auto _ : state) {
+        gb::AxpyMod<Simd>(y.data(), x.data(), y.size(), c, kPrime);
+        bm::DoNotOptimize(y.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 64 row operations row -= c_k * pivot_k on one dense row
+static void RowOperationsModulus(bm::State &state) {
+    std::mt19937 rng(34);
+    std::vector<std::vector<WideModInt>> pivots;
+    for (size_t k = 0; k < 64; ++k) {
+        auto pivot = BuildRandomRow(state.range(0), rng);
+        pivots.emplace_back(pivot.begin(), pivot.end());
+    }
+    auto start = BuildRandomRow(state.range(0), rng);
+
+    for (auto _ : state) {
+        std::vector<WideModInt> row(start.begin(), start.end());
+        for (size_t k = 0; k < pivots.size(); ++k) {
+            WideModInt c(k + 1);
+            for (size_t i = 0; i < row.size(); ++i) {
+                row[i] -= c * pivots[k][i];
+            }
+        }
+        bm::DoNotOptimize(row.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 64);
+}
+
+static void RowOperationsAccumulator(bm::State &state) {
+    std::mt19937 rng(34);
+    std::vector<std::vector<uint32_t>> pivots;
+    for (size_t k = 0; k < 64; ++k) {
+        pivots.push_back(BuildRandomRow(state.range(0), rng));
+    }
+    auto start = BuildRandomRow(state.range(0), rng);
+    std::vector<uint32_t> result(start.size());
+    gb::DenseRowAccumulator accumulator(start.size(), kPrime);
+
+    for (auto _ : state) {
+        accumulator.Assign(start.data());
+        for (size_t k = 0; k < pivots.size(); ++k) {
+            accumulator.SubtractMultiple(pivots[k].data(), k + 1);
+        }
+        accumulator.Extract(result.data());
+        bm::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 64);
+}
+
+using GF2 = gb::Modulus<int, 2>;
+
+// n random quadratic equations in n variables with 2n terms each
+static std::vector<gb::Polynom<GF2>> BuildQuadraticSystem(size_t n) {
+    std::mt19937 rng(35);
+    std::vector<gb::Polynom<GF2>> system;
+
+    for (size_t k = 0; k < n; ++k) {
+        gb::Polynom<GF2>::Builder poly;
+        for (size_t t = 0; t < 2 * n; ++t) {
+            std::vector<gb::Monom::Degree> degrees(n);
+            degrees[rng() % n] = 1;
+            degrees[rng() % n] = 1;
+            poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        system.push_back(poly.BuildPolynom());
+    }
+    return system;
+}
+
+// Modulus<int, 2> with the field equations x_i^2 + x_i added explicitly
+static void QuadraticSystemModulus(bm::State &state) {
+    size_t n = state.range(0);
+    gb::PolynomialsSet<GF2> s;
+    for (const auto &f : BuildQuadraticSystem(n)) {
+        s.Add(f);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<gb::Monom::Degree> square(n), variable(n);
+        square[i] = 2;
+        variable[i] = 1;
+        gb::Polynom<GF2>::Builder poly;
+        poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(square));
+        poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(variable));
+        s.Add(poly.BuildPolynom());
+    }
+
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        bm::DoNotOptimize(temp);
+    }
+}
+
+static void QuadraticSystemBoolean(bm::State &state) {
+    gb::BooleanPolynomialsSet<> s;
+    for (const auto &f : BuildQuadraticSystem(state.range(0))) {
+        s.Add(gb::BooleanPolynom<>::FromPolynom(f));
+    }
+
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        bm::DoNotOptimize(temp);
+    }
+}
+
+static std::vector<ModInt> BuildRandomPoints(size_t count, size_t dimension) {
+    std::mt19937 rng(36);
+    std::vector<ModInt> points(count * dimension);
+    for (auto &value : points) {
+        value = rng() % 239;
+    }
+    return points;
+}
+
+// Basis of cyclic-5 at 4096 random points
+static void EvaluateNaive(bm::State &state) {
+    auto basis = BuildCyclic(5);
+    basis.BuildGreobnerBasis();
+    auto points = BuildRandomPoints(4096, 5);
+
+    for (auto _ : state) {
+        for (size_t p = 0; p < 4096; ++p) {
+            std::vector<ModInt> point(points.begin() + p * 5, points.begin() + (p + 1) * 5);
+            for (const auto &f : basis) {
+                bm::DoNotOptimize(f.Evaluate(point));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+
+static void EvaluateCompiled(bm::State &state) {
+    auto basis = BuildCyclic(5);
+    basis.BuildGreobnerBasis();
+    auto points = BuildRandomPoints(4096, 5);
+    gb::Evaluator<ModInt> evaluator(basis);
+
+    for (auto _ : state) {
+        bm::DoNotOptimize(evaluator.EvaluateBatch(points));
+    }
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+
+// The same supports with random nonzero coefficients. The prime is large, so the run
+// is generic and follows the trace; modulo 239 accidental cancellations are too frequent.
+static gb::PolynomialsSet<WideModInt> RandomizeCoefficients(
+    const gb::PolynomialsSet<ModInt> &set, std::mt19937 &rng) {
+    gb::PolynomialsSet<WideModInt> result;
+    for (const auto &f : set) {
+        gb::Polynom<WideModInt>::Builder poly;
+        for (const auto &t : f) {
+            poly.AddTerm(static_cast<int64_t>(rng() % (kPrime - 1)) + 1, t.GetMonom());
+        }
+        result.Add(poly.BuildPolynom());
+    }
+    return result;
+}
+
+static void CyclicRandomCoefficients(bm::State &state) {
+    std::mt19937 rng(37);
+    auto cyclic = BuildCyclic(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto s = RandomizeCoefficients(cyclic, rng);
+        state.ResumeTiming();
+        s.BuildGreobnerBasis();
+        bm::DoNotOptimize(s);
+    }
+}
+
+static void CyclicReplay(bm::State &state) {
+    std::mt19937 rng(37);
+    auto cyclic = BuildCyclic(state.range(0));
+
+    gb::GroebnerTrace trace;
+    gb::ComputationContext context;
+    RandomizeCoefficients(cyclic, rng).BuildGreobnerBasis(context, trace);
+
+    size_t replayed = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto s = RandomizeCoefficients(cyclic, rng);
+        state.ResumeTiming();
+        replayed += s.ReplayGroebnerBasis(trace);
+        bm::DoNotOptimize(s);
+    }
+    state.counters["replayed"] = bm::Counter(replayed, bm::Counter::kAvgIterations);
+}
+
+// Repeated builds of one ideal, the cache is warmed by the first build
+static void CyclicCached(bm::State &state) {
+
+    auto s = BuildCyclic(state.range(0));
+    gb::NormalFormCache<ModInt> cache;
+    s.SetNormalFormCache(&cache);
+    auto warm = s;
+    warm.BuildGreobnerBasis();
+
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        bm::DoNotOptimize(temp);
+    }
+    state.counters["hits"] = bm::Counter(cache.Hits(), bm::Counter::kAvgIterations);
+}
+
+// The same builds as Cyclic with cofactor records, without expanding them
+static void CyclicCofactors(bm::State &state) {
+
+    gb::PolynomialsSet<ModInt, gb::GrevLexOrder, gb::TrackCofactors> s;
+    for (const auto &f : BuildCyclic(state.range(0))) {
+        s.Add(f);
+    }
+
+    gb::CofactorStats stats;
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        stats = temp.GetCofactorStats();
+        bm::DoNotOptimize(temp);
+    }
+    state.counters["records"] = stats.records;
+    state.counters["bytes"] = stats.memory_bytes;
+}
+
+// Small 3-variable ideals of binomials like the ones in tests.txt
+static std::vector<gb::PolynomialsSet<ModInt>> BuildSmallIdeals(size_t count) {
+
+    std::mt19937 rng(40);
+    std::vector<gb::PolynomialsSet<ModInt>> ideals(count);
+    for (auto &ideal : ideals) {
+        for (size_t k = 0; k < 3; ++k) {
+            gb::Polynom<ModInt>::Builder poly;
+            for (size_t t = 0; t < 2; ++t) {
+                std::vector<gb::Monom::Degree> degrees(3);
+                for (auto &degree : degrees) {
+                    degree = rng() % 7;
+                }
+                poly.AddTerm(static_cast<int>(rng() % 10) + 1,
+                             gb::Monom::BuildFromVectorDegrees(degrees));
+            }
+            ideal.Add(poly.BuildPolynom());
+        }
+    }
+    return ideals;
+}
+
+static void SmallIdealsSequential(bm::State &state) {
+
+    auto ideals = BuildSmallIdeals(1000);
+    gb::PolynomialsSet<ModInt> s;
+    for (auto _ : state) {
+        for (const auto &ideal : ideals) {
+            s = ideal;
+            s.BuildGreobnerBasis();
+            bm::DoNotOptimize(s);
+        }
+    }
+    state.counters["ideals"] = bm::Counter(state.iterations() * ideals.size(), bm::Counter::kIsRate);
+}
+
+static void SmallIdealsBatch(bm::State &state) {
+
+    auto ideals = BuildSmallIdeals(1000);
+    gb::ThreadPool pool(state.range(0));
+    gb::BatchSolver<ModInt> solver(pool);
+    for (auto _ : state) {
+        size_t next = 0;
+        solver.Solve(
+            [&]() -> std::optional<gb::PolynomialsSet<ModInt>> {
+                if (next == ideals.size()) {
+                    return std::nullopt;
+                }
+                return ideals[next++];
+            },
+            [](size_t, gb::PolynomialsSet<ModInt> &&basis) { bm::DoNotOptimize(basis); });
+    }
+    state.counters["ideals"] = bm::Counter(state.iterations() * ideals.size(), bm::Counter::kIsRate);
+}
+
+// Cyclic n homogenized by the variable n
+static gb::PolynomialsSet<ModInt> BuildHomogeneousCyclic(int n) {
+
+    gb::PolynomialsSet<ModInt> result;
+    for (const auto &f : BuildCyclic(n)) {
+        gb::Polynom<ModInt>::Builder poly;
+        for (const auto &t : f) {
+            std::vector<gb::Monom::Degree> degrees(n + 1, 0);
+            degrees[n] = f.GetLargestTerm().TotalDegree() - t.TotalDegree();
+            poly.AddTerm(t.GetCoefficient(),
+                         t.GetMonom() * gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        result.Add(poly.BuildPolynom());
+    }
+    return result;
+}
+
+static void HomogeneousCyclicBuild(bm::State &state) {
+
+    auto s = BuildHomogeneousCyclic(state.range(0));
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        bm::DoNotOptimize(temp);
+    }
+}
+
+// Time to the first element of the stream, all elements if the argument is 1
+static void HomogeneousCyclicStream(bm::State &state) {
+
+    auto s = BuildHomogeneousCyclic(state.range(0));
+    for (auto _ : state) {
+        gb::GroebnerBasisStream<ModInt> stream(s);
+        size_t count = stream.Next().has_value();
+        while (state.range(1) && stream.Next()) {
+            ++count;
+        }
+        bm::DoNotOptimize(count);
+    }
+}
+
+// Dense polynomials in 4 variables of degree below state.range(1) with state.range(0) terms
+static gb::Polynom<ModInt> BuildRandomPolynom(size_t terms, size_t degree, std::mt19937 &rng) {
+    gb::Polynom<ModInt>::Builder poly;
+    for (size_t k = 0; k < terms; ++k) {
+        std::vector<gb::Monom::Degree> degrees(4);
+        for (auto &d : degrees) {
+            d = rng() % degree;
+        }
+        poly.AddTerm(static_cast<int>(rng() % 238) + 1, gb::Monom::BuildFromVectorDegrees(degrees));
+    }
+    return poly.BuildPolynom();
+}
+
+// All term products sorted at once, as operator* does for small operands
+static void ProductSort(bm::State &state) {
+
+    std::mt19937 rng(42);
+    auto f = BuildRandomPolynom(state.range(0), state.range(1), rng);
+    auto g = BuildRandomPolynom(state.range(0), state.range(1), rng);
+    for (auto _ : state) {
+        gb::Polynom<ModInt>::Builder product;
+        for (const auto &a : f) {
+            for (const auto &b : g) {
+                product.AddTerm(a * b);
+            }
+        }
+        bm::DoNotOptimize(product.BuildPolynom());
+    }
+}
+
+static void ProductHeap(bm::State &state) {
+
+    std::mt19937 rng(42);
+    auto f = BuildRandomPolynom(state.range(0), state.range(1), rng);
+    auto g = BuildRandomPolynom(state.range(0), state.range(1), rng);
+    for (auto _ : state) {
+        bm::DoNotOptimize(f * g);
+    }
+}
+
+static void ProductParallel(bm::State &state) {
+
+    std::mt19937 rng(42);
+    auto f = BuildRandomPolynom(state.range(0), state.range(1), rng);
+    auto g = BuildRandomPolynom(state.range(0), state.range(1), rng);
+    gb::ThreadPool pool(state.range(2));
+    for (auto _ : state) {
+        bm::DoNotOptimize(Multiply(f, g, pool));
+    }
+}
+
+static void SmallIdealsFastPaths(bm::State &state) {
+
+    auto ideals = BuildSmallIdeals(200);
+    gb::PolynomialsSet<ModInt> s;
+    for (auto _ : state) {
+        for (const auto &ideal : ideals) {
+            s = ideal;
+            s.SetFastPaths(state.range(0));
+            s.BuildGreobnerBasis();
+            bm::DoNotOptimize(s);
+        }
+    }
+}
+
+// Random polynomials of one of the special shapes: linear in vars variables, or univariate of
+// degree vars with a common factor of degree vars / 2
+static gb::PolynomialsSet<ModInt> BuildShapedIdeal(size_t vars, bool linear) {
+
+    std::mt19937 rng(43);
+    auto random = [&](size_t terms, auto degrees) {
+        gb::Polynom<ModInt>::Builder poly;
+        for (size_t t = 0; t < terms; ++t) {
+            poly.AddTerm(static_cast<int>(rng() % 100) + 1, degrees(t));
+        }
+        return poly.BuildPolynom();
+    };
+
+    gb::PolynomialsSet<ModInt> s;
+    if (linear) {
+        auto variable = [&](size_t t) {
+            std::vector<gb::Monom::Degree> degrees(vars);
+            if (t < vars) {
+                degrees[t] = 1;
+            }
+            return gb::Monom::BuildFromVectorDegrees(degrees);
+        };
+        for (size_t k = 0; k < vars; ++k) {
+            s.Add(random(vars + 1, variable));
+        }
+    } else {
+        auto power = [](size_t t) {
+            return gb::Monom::BuildFromVectorDegrees({static_cast<gb::Monom::Degree>(t)});
+        };
+        auto factor = random(vars / 2 + 1, power);
+        for (size_t k = 0; k < 3; ++k) {
+            s.Add(random(vars - vars / 2 + 1, power) * factor);
+        }
+    }
+    return s;
+}
+
+static void ShapedIdeal(bm::State &state) {
+
+    auto ideal = BuildShapedIdeal(state.range(0), state.range(1));
+    gb::PolynomialsSet<ModInt> s;
+    for (auto _ : state) {
+        s = ideal;
+        s.SetFastPaths(state.range(2));
+        s.BuildGreobnerBasis();
+        bm::DoNotOptimize(s);
+    }
+}
+
+// Cyclic n over the rationals, Field is Rational, cpp_rational or boost::rational
+template <typename Field>
+static void CyclicExact(bm::State &state) {
+
+    gb::PolynomialsSet<Field> s;
+    for (const auto &f : BuildCyclic(state.range(0))) {
+        typename gb::Polynom<Field>::Builder poly;
+        for (const auto &t : f) {
+            int32_t c = t.GetCoefficient().GetValue();
+            poly.AddTerm(Field(c > ModInt::kModulus / 2 ? c - ModInt::kModulus : c), t.GetMonom());
+        }
+        s.Add(poly.BuildPolynom());
+    }
+
+    for (auto _ : state) {
+        auto temp = s;
+        temp.BuildGreobnerBasis();
+        bm::DoNotOptimize(temp);
+    }
+}
+
 }  // namespace
 
+BENCHMARK(NormalFormSequential)->Unit(bm::kMillisecond)->UseRealTime();
+BENCHMARK(NormalFormReducer)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(bm::kMillisecond)->UseRealTime();
+
+BENCHMARK(AxpyModulus)->Arg(4096);
+BENCHMARK(AxpyKernel<gb::simd::Scalar>)->Arg(4096);
+BENCHMARK(AxpyKernel<gb::simd::Native>)->Arg(4096);
+BENCHMARK(RowOperationsModulus)->Arg(4096);
+BENCHMARK(RowOperationsAccumulator)->Arg(4096);
+
+BENCHMARK(QuadraticSystemModulus)->Arg(6)->Arg(8)->Unit(bm::kMillisecond);
+BENCHMARK(QuadraticSystemBoolean)->Arg(6)->Arg(8)->Unit(bm::kMillisecond);
+
+BENCHMARK(EvaluateNaive)->Unit(bm::kMillisecond);
+BENCHMARK(EvaluateCompiled)->Unit(bm::kMillisecond);
+
+BENCHMARK(CyclicRandomCoefficients)->Arg(5)->Iterations(20)->Unit(bm::kMillisecond);
+BENCHMARK(CyclicReplay)->Arg(5)->Iterations(20)->Unit(bm::kMillisecond);
+
+BENCHMARK(SmallIdealsSequential)->Unit(bm::kMillisecond)->UseRealTime();
+BENCHMARK(SmallIdealsBatch)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(bm::kMillisecond)->UseRealTime();
+
+BENCHMARK(HomogeneousCyclicBuild)->Arg(5)->Iterations(10)->Unit(bm::kMillisecond);
+BENCHMARK(HomogeneousCyclicStream)->Args({5, 0})->Args({5, 1})->Iterations(10)->Unit(bm::kMillisecond);
+
+BENCHMARK(ProductSort)->Args({32, 4})->Args({200, 8})->Args({1000, 12})->Unit(bm::kMillisecond);
+BENCHMARK(ProductHeap)->Args({32, 4})->Args({200, 8})->Args({1000, 12})->Unit(bm::kMillisecond);
+BENCHMARK(ProductParallel)->Args({1000, 12, 1})->Args({1000, 12, 4})->Unit(bm::kMillisecond)->UseRealTime();
+
+BENCHMARK(SmallIdealsFastPaths)->Arg(0)->Arg(1)->Unit(bm::kMillisecond);
+BENCHMARK(ShapedIdeal)->Args({12, 1, 0})->Args({12, 1, 1})->Unit(bm::kMillisecond);
+BENCHMARK(ShapedIdeal)->Args({40, 0, 0})->Args({40, 0, 1})->Unit(bm::kMillisecond);
+
+BENCHMARK(CyclicExact<boost::rational<int64_t>>)->Arg(4)->Unit(bm::kMillisecond);
+BENCHMARK(CyclicExact<boost::multiprecision::cpp_rational>)->Arg(4)->Arg(5)->Unit(bm::kMillisecond);
+BENCHMARK(CyclicExact<gb::Rational>)->Arg(4)->Arg(5)->Unit(bm::kMillisecond);
+
+BENCHMARK(CyclicCached)->Arg(5)->Iterations(10)->Unit(bm::kMillisecond);
+BENCHMARK(CyclicCofactors)->Arg(4)->Iterations(1000)->Unit(bm::kMillisecond);
+BENCHMARK(CyclicCofactors)->Arg(5)->Iterations(10)->Unit(bm::kMillisecond);
+
 BENCHMARK(Cyclic)->Arg(4)->Iterations(1000)->Unit(bm::kMillisecond);
 BENCHMARK(Cyclic)->Arg(5)->Iterations(10)->Unit(bm::kMillisecond);
 BENCHMARK(Cyclic)->Arg(6)->Iterations(1)->Unit(bm::kSecond);
+BENCHMARK(CyclicFullReduction)->Arg(4)->Iterations(1000)->Unit(bm::kMillisecond);
+BENCHMARK(CyclicFullReduction)->Arg(5)->Iterations(10)->Unit(bm::kMillisecond);
 
 BENCHMARK_MAIN();
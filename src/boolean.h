@@ -0,0 +1,533 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "context.h"
+#include "orders.h"
+#include "polynom.h"
+#include "types.h"
+
+namespace groebner_basis {
+
+// Polynomials over GF(2) modulo the field equations x_i^2 = x_i. Every exponent is 0 or 1 and
+// every coefficient is 1, so a monomial is a bitset of its variables and a polynomial is the
+// sorted set of its monomials: addition is the symmetric difference of two sets.
+
+template <size_t MaxVariables = 64>
+class BooleanMonom {
+public:
+    static constexpr size_t kWords = (MaxVariables + 63) / 64;
+
+    BooleanMonom() = default;
+
+    static BooleanMonom Variable(size_t index) {
+        BooleanMonom monom;
+        monom.Set(index);
+        return monom;
+    }
+
+    // Exponents above one are the same as one
+    static BooleanMonom FromMonom(const Monom& monom) {
+        assert(monom.FirstIndexAfterLastNonZeroDegree() <= MaxVariables);
+
+        BooleanMonom result;
+        for (auto it = monom.begin(); it != monom.end(); ++it) {
+            if (*it != 0) {
+                result.Set(it - monom.begin());
+            }
+        }
+        return result;
+    }
+
+    Monom ToMonom() const {
+        std::vector<Monom::Degree> degrees(MaxVariables);
+        for (size_t i = 0; i < MaxVariables; ++i) {
+            degrees[i] = Has(i);
+        }
+        return Monom::BuildFromVectorDegrees(degrees);
+    }
+
+    bool Has(size_t index) const {
+        return (words_[index / 64] >> (index % 64)) & 1;
+    }
+
+    void Set(size_t index) {
+        assert(index < MaxVariables);
+        words_[index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    size_t Degree() const {
+        size_t degree = 0;
+        for (auto word : words_) {
+            degree += std::popcount(word);
+        }
+        return degree;
+    }
+
+    bool IsDivisibleBy(const BooleanMonom& divisor) const {
+        for (size_t i = 0; i < kWords; ++i) {
+            if (divisor.words_[i] & ~words_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::array<uint64_t, kWords>& GetWords() const {
+        return words_;
+    }
+
+    friend BooleanMonom operator*(BooleanMonom first, const BooleanMonom& second) {
+        for (size_t i = 0; i < kWords; ++i) {
+            first.words_[i] |= second.words_[i];
+        }
+        return first;
+    }
+
+    // The smallest quotient: the variables of first that are not in second
+    friend BooleanMonom operator/(BooleanMonom first, const BooleanMonom& second) {
+        assert(first.IsDivisibleBy(second));
+        for (size_t i = 0; i < kWords; ++i) {
+            first.words_[i] &= ~second.words_[i];
+        }
+        return first;
+    }
+
+    friend bool operator==(const BooleanMonom&, const BooleanMonom&) = default;
+
+    template <typename Stream>
+    friend Stream& operator<<(Stream& stream, const BooleanMonom& monom) {
+        bool is_one = true;
+        for (size_t i = 0; i < MaxVariables; ++i) {
+            if (monom.Has(i)) {
+                stream << "x" << i;
+                is_one = false;
+            }
+        }
+        if (is_one) {
+            stream << "1";
+        }
+        return stream;
+    }
+
+private:
+    std::array<uint64_t, kWords> words_{};
+};
+
+// Comparators of BooleanMonom that agree with the orders of Monom on multilinear monomials
+template <typename Order>
+struct BooleanOrder;
+
+template <>
+struct BooleanOrder<GrevLexOrder> {
+    template <size_t MaxVariables>
+    bool operator()(const BooleanMonom<MaxVariables>& a,
+                    const BooleanMonom<MaxVariables>& b) const {
+
+        size_t degree_a = a.Degree(), degree_b = b.Degree();
+        if (degree_a != degree_b) {
+            return degree_a > degree_b;
+        }
+
+        // the larger monomial misses the last variable in which they differ
+        for (size_t i = BooleanMonom<MaxVariables>::kWords; i-- > 0;) {
+            uint64_t diff = a.GetWords()[i] ^ b.GetWords()[i];
+            if (diff) {
+                return (b.GetWords()[i] >> (63 - std::countl_zero(diff))) & 1;
+            }
+        }
+        return false;
+    }
+};
+
+template <>
+struct BooleanOrder<LexOrder> {
+    template <size_t MaxVariables>
+    bool operator()(const BooleanMonom<MaxVariables>& a,
+                    const BooleanMonom<MaxVariables>& b) const {
+
+        // the larger monomial has the first variable in which they differ
+        for (size_t i = 0; i < BooleanMonom<MaxVariables>::kWords; ++i) {
+            uint64_t diff = a.GetWords()[i] ^ b.GetWords()[i];
+            if (diff) {
+                return (a.GetWords()[i] >> std::countr_zero(diff)) & 1;
+            }
+        }
+        return false;
+    }
+};
+
+template <size_t MaxVariables = 64, typename Order = GrevLexOrder>
+class BooleanPolynom {
+public:
+    using MonomType = BooleanMonom<MaxVariables>;
+
+    BooleanPolynom() = default;
+
+    explicit BooleanPolynom(const MonomType& monom) : data_{monom} {
+    }
+
+    // Equal monomials cancel in pairs
+    explicit BooleanPolynom(std::vector<MonomType> monoms) : data_(std::move(monoms)) {
+        std::sort(data_.begin(), data_.end(), BooleanOrder<Order>());
+        CancelPairs(data_);
+    }
+
+    // monoms must be sorted by Order, the largest first, without repetitions
+    static BooleanPolynom BuildFromOrderedMonoms(std::vector<MonomType>&& monoms) {
+        BooleanPolynom result;
+        result.data_ = std::move(monoms);
+        assert(std::adjacent_find(result.begin(), result.end(), [](const auto& a, const auto& b) {
+                   return !BooleanOrder<Order>()(a, b);
+               }) == result.end());
+        return result;
+    }
+
+    // A polynomial over GF(2): its terms become monomials, exponents above one become one
+    template <typename Field, typename FromOrder>
+        requires(Field::kModulus == 2)
+    static BooleanPolynom FromPolynom(const Polynom<Field, FromOrder>& poly) {
+        std::vector<MonomType> monoms;
+        for (const auto& term : poly) {
+            if (term.GetCoefficient() != Field(0)) {
+                monoms.push_back(MonomType::FromMonom(term.GetMonom()));
+            }
+        }
+        return BooleanPolynom(std::move(monoms));
+    }
+
+    template <typename Field>
+    Polynom<Field, Order> ToPolynom() const {
+        typename Polynom<Field, Order>::Builder poly;
+        for (const auto& monom : data_) {
+            poly.AddTerm(Field(1), monom.ToMonom());
+        }
+        return poly.BuildPolynom();
+    }
+
+    static BooleanPolynom BuildFromString(const std::string& str) {
+        return FromPolynom(Polynom<Modulus<int, 2>, Order>::BuildFromString(str));
+    }
+
+    auto begin() const {  // NOLINT
+        return data_.begin();
+    }
+
+    auto end() const {  // NOLINT
+        return data_.end();
+    }
+
+    bool IsZero() const {
+        return data_.empty();
+    }
+
+    size_t TermsCount() const {
+        return data_.size();
+    }
+
+    const MonomType& GetLargestMonom() const {
+        assert(!IsZero());
+        return data_.front();
+    }
+
+    BooleanPolynom& operator+=(const BooleanPolynom& other) {
+        return *this = *this + other;
+    }
+
+    friend BooleanPolynom operator+(const BooleanPolynom& first, const BooleanPolynom& second) {
+        BooleanPolynom result;
+        result.data_.reserve(first.TermsCount() + second.TermsCount());
+        std::set_symmetric_difference(first.begin(), first.end(), second.begin(), second.end(),
+                                      std::back_inserter(result.data_), BooleanOrder<Order>());
+        return result;
+    }
+
+    friend BooleanPolynom operator-(const BooleanPolynom& first, const BooleanPolynom& second) {
+        return first + second;
+    }
+
+    friend BooleanPolynom operator*(const BooleanPolynom& poly, const MonomType& monom) {
+        std::vector<MonomType> product;
+        product.reserve(poly.TermsCount());
+        for (const auto& t : poly) {
+            product.push_back(t * monom);
+        }
+        return BooleanPolynom(std::move(product));
+    }
+
+    friend BooleanPolynom operator*(const BooleanPolynom& first, const BooleanPolynom& second) {
+        std::vector<MonomType> product;
+        product.reserve(first.TermsCount() * second.TermsCount());
+        for (const auto& a : first) {
+            for (const auto& b : second) {
+                product.push_back(a * b);
+            }
+        }
+        return BooleanPolynom(std::move(product));
+    }
+
+    friend bool operator==(const BooleanPolynom&, const BooleanPolynom&) = default;
+
+    // Same as for Polynom: the polynomial with the larger first different term goes first
+    friend bool operator<(const BooleanPolynom& first, const BooleanPolynom& second) {
+        auto [it1, it2] = std::mismatch(first.begin(), first.end(), second.begin(), second.end());
+        if (it1 == first.end() || it2 == second.end()) {
+            return first.TermsCount() > second.TermsCount();
+        }
+        return BooleanOrder<Order>()(*it1, *it2);
+    }
+
+    template <typename Stream>
+    friend Stream& operator<<(Stream& stream, const BooleanPolynom& poly) {
+        if (poly.IsZero()) {
+            stream << "0";
+        }
+        for (auto it = poly.begin(); it != poly.end(); ++it) {
+            stream << (it == poly.begin() ? "" : " + ") << *it;
+        }
+        return stream;
+    }
+
+private:
+    static void CancelPairs(std::vector<MonomType>& monoms) {
+        size_t size = 0;
+        for (size_t i = 0; i < monoms.size();) {
+            size_t j = i;
+            while (j < monoms.size() && monoms[j] == monoms[i]) {
+                ++j;
+            }
+            if ((j - i) % 2 == 1) {
+                monoms[size++] = monoms[i];
+            }
+            i = j;
+        }
+        monoms.resize(size);
+    }
+
+    std::vector<MonomType> data_;
+};
+
+// The Buchberger driver of PolynomialsSet for Boolean polynomials. Besides the S-polynomials
+// of two elements it reduces g + x_i * g for every variable x_i of the leading monomial of g,
+// which are the S-polynomials of g with the field equations. The result is the reduced
+// Groebner basis of the input together with the field equations, without the field equations
+// themselves. Only GrevLexOrder and LexOrder are supported.
+template <size_t MaxVariables = 64, typename Order = GrevLexOrder>
+class BooleanPolynomialsSet {
+public:
+    using PolynomType = BooleanPolynom<MaxVariables, Order>;
+    using MonomType = BooleanMonom<MaxVariables>;
+    using Container = std::vector<PolynomType>;
+    using Iterator = typename Container::iterator;
+
+    BooleanPolynomialsSet(std::initializer_list<PolynomType> poly_list) {
+        for (const auto& f : poly_list) {
+            Add(f);
+        }
+    }
+
+    BooleanPolynomialsSet() = default;
+
+    auto begin() {  // NOLINT
+        return data_.begin();
+    }
+
+    auto end() {  // NOLINT
+        return data_.end();
+    }
+
+    auto begin() const {  // NOLINT
+        return data_.begin();
+    }
+
+    auto end() const {  // NOLINT
+        return data_.end();
+    }
+
+    size_t Size() const {
+        return data_.size();
+    }
+
+    bool operator==(const BooleanPolynomialsSet& other) const {
+        return data_ == other.data_;
+    }
+
+    bool operator!=(const BooleanPolynomialsSet& other) const {
+        return !(*this == other);
+    }
+
+    void Add(const PolynomType& poly) {
+        if (!poly.IsZero()) {
+            data_.push_back(poly);
+        }
+    }
+
+    void Erase(Iterator it) {
+        cursor_ = PairCursor();
+        if (it != data_.end()) {
+            data_.erase(it);
+        }
+    }
+
+    void Clear() {
+        data_.clear();
+        cursor_ = PairCursor();
+    }
+
+    // Full reduction; std::nullopt if no term of f is divisible by a leading monomial
+    std::optional<PolynomType> Reduce(const PolynomType& f) const {
+
+        std::vector<MonomType> remainder;
+        PolynomType current = f;
+        bool reduced = false;
+
+        while (!current.IsZero()) {
+            const MonomType& leading = current.GetLargestMonom();
+            auto g = FindReductor(leading);
+            if (g == end()) {
+                remainder.push_back(leading);
+                current = PolynomType::BuildFromOrderedMonoms({current.begin() + 1, current.end()});
+                continue;
+            }
+            current += *g * (leading / g->GetLargestMonom());
+            reduced = true;
+        }
+
+        if (!reduced) {
+            return std::nullopt;
+        }
+        return PolynomType::BuildFromOrderedMonoms(std::move(remainder));
+    }
+
+    void BuildGreobnerBasis() {
+        ComputationContext context;
+        BuildGreobnerBasis(context);
+    }
+
+    ComputationStatus BuildGreobnerBasis(ComputationContext& context) {
+
+        if (!BuildUnReducedGroebnerBasis(context)) {
+            return context.GetStatus();
+        }
+        InterReduce();
+        std::sort(begin(), end());
+        return ComputationStatus::kCompleted;
+    }
+
+private:
+    typename Container::const_iterator FindReductor(const MonomType& monom) const {
+        return std::find_if(begin(), end(), [&](const PolynomType& g) {
+            return monom.IsDivisibleBy(g.GetLargestMonom());
+        });
+    }
+
+    // Reduces only the leading monomial
+    PolynomType TopReduce(PolynomType f, ComputationContext& context, size_t basis_terms) const {
+        while (!f.IsZero() && !context.ShouldStop(basis_terms + f.TermsCount())) {
+            const MonomType& leading = f.GetLargestMonom();
+            auto g = FindReductor(leading);
+            if (g == end()) {
+                break;
+            }
+            f += *g * (leading / g->GetLargestMonom());
+        }
+        return f;
+    }
+
+    // cursor_.j == cursor_.i stands for the field equation pairs of element i
+    bool BuildUnReducedGroebnerBasis(ComputationContext& context) {
+
+        size_t basis_terms = 0;
+        for (const auto& f : data_) {
+            basis_terms += f.TermsCount();
+        }
+
+        auto add_reduced = [&](const PolynomType& s) {
+            if (s.IsZero()) {
+                return;
+            }
+            auto r = TopReduce(s, context, basis_terms);
+            if (context.GetStatus() == ComputationStatus::kCompleted && !r.IsZero()) {
+                basis_terms += r.TermsCount();
+                data_.push_back(std::move(r));
+            }
+        };
+
+        for (; cursor_.i < Size(); ++cursor_.i, cursor_.j = 0) {
+            for (; cursor_.j <= cursor_.i; ++cursor_.j) {
+                size_t i = cursor_.i, j = cursor_.j;
+
+                if (context.ShouldStop(basis_terms)) {
+                    return false;
+                }
+
+                if (j == i) {
+                    MonomType leading = data_[i].GetLargestMonom();
+                    for (size_t variable = 0; variable < MaxVariables; ++variable) {
+                        if (leading.Has(variable)) {
+                            const PolynomType& g = data_[i];
+                            add_reduced(g + g * MonomType::Variable(variable));
+                        }
+                    }
+                } else {
+                    add_reduced(SPolynom(data_[i], data_[j]));
+                }
+
+                if (context.GetStatus() != ComputationStatus::kCompleted) {
+                    return false;
+                }
+            }
+        }
+
+        cursor_ = PairCursor();
+        return true;
+    }
+
+    static PolynomType SPolynom(const PolynomType& f, const PolynomType& g) {
+        const MonomType& a = f.GetLargestMonom();
+        const MonomType& b = g.GetLargestMonom();
+        MonomType lcm = a * b;
+        return f * (lcm / a) + g * (lcm / b);
+    }
+
+    void InterReduce() {
+
+        // minimal basis: no leading monomial divides another one
+        std::stable_sort(data_.begin(), data_.end(), [](const auto& f, const auto& g) {
+            return f.GetLargestMonom().Degree() < g.GetLargestMonom().Degree();
+        });
+        Container minimal;
+        for (auto& f : data_) {
+            bool divisible = std::any_of(minimal.begin(), minimal.end(), [&](const auto& g) {
+                return f.GetLargestMonom().IsDivisibleBy(g.GetLargestMonom());
+            });
+            if (!divisible) {
+                minimal.push_back(std::move(f));
+            }
+        }
+        data_ = std::move(minimal);
+
+        // the leading monomials stay, so every tail is reduced against all of them
+        for (auto& f : data_) {
+            auto reduced = Reduce(PolynomType::BuildFromOrderedMonoms({f.begin() + 1, f.end()}));
+            if (reduced) {
+                f = PolynomType(f.GetLargestMonom()) + reduced.value();
+            }
+        }
+        cursor_ = PairCursor();
+    }
+
+    Container data_;
+    PairCursor cursor_;
+};
+
+}  // namespace groebner_basis
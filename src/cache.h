@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include "polynom.h"
+
+namespace groebner_basis {
+
+// Remainders computed before, keyed by a fingerprint of the basis they were reduced by and the
+// reduced polynomial. At most capacity entries are kept, the least recently used are dropped.
+// The entries are split into shards with their own locks, so the cache can be shared by
+// computations running on different threads.
+template <typename Field, typename Order = GrevLexOrder>
+class NormalFormCache {
+    // an entry is found by the fingerprint of its basis, which ignores the coefficients
+    // without a hash, so bases differing only in them would share the remainders
+    static_assert(HashableField<Field>, "NormalFormCache needs std::hash of the coefficients");
+
+public:
+    using PolynomType = Polynom<Field, Order>;
+
+    static constexpr size_t kShardsCount = 16;
+
+    explicit NormalFormCache(size_t capacity = 1 << 16)
+        : shard_capacity_(std::max<size_t>(capacity / kShardsCount, 1)) {
+    }
+
+    NormalFormCache(const NormalFormCache&) = delete;
+    NormalFormCache& operator=(const NormalFormCache&) = delete;
+
+    std::optional<PolynomType> Find(uint64_t basis, const PolynomType& f) {
+
+        size_t hash = HashCombine(basis, f.Hash());
+        Shard& shard = shards_[hash % kShardsCount];
+        std::lock_guard lock(shard.mutex);
+
+        auto entry = shard.Find(hash, basis, f);
+        if (entry == shard.entries.end()) {
+            ++shard.misses;
+            return std::nullopt;
+        }
+
+        ++shard.hits;
+        shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+        return entry->normal_form;
+    }
+
+    void Insert(uint64_t basis, const PolynomType& f, const PolynomType& normal_form) {
+
+        size_t hash = HashCombine(basis, f.Hash());
+        Shard& shard = shards_[hash % kShardsCount];
+        std::lock_guard lock(shard.mutex);
+
+        auto entry = shard.Find(hash, basis, f);
+        if (entry != shard.entries.end()) {
+            entry->normal_form = normal_form;
+            shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+            return;
+        }
+
+        shard.entries.push_front({hash, basis, f, normal_form});
+        shard.index.emplace(hash, shard.entries.begin());
+
+        if (shard.entries.size() > shard_capacity_) {
+            auto last = std::prev(shard.entries.end());
+            auto [begin, end] = shard.index.equal_range(last->hash);
+            shard.index.erase(std::find_if(begin, end, [&](const auto& item) {
+                return item.second == last;
+            }));
+            shard.entries.pop_back();
+        }
+    }
+
+    size_t Size() const {
+        return Sum([](const Shard& shard) { return shard.entries.size(); });
+    }
+
+    size_t Hits() const {
+        return Sum([](const Shard& shard) { return shard.hits; });
+    }
+
+    size_t Misses() const {
+        return Sum([](const Shard& shard) { return shard.misses; });
+    }
+
+    void Clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard lock(shard.mutex);
+            shard.entries.clear();
+            shard.index.clear();
+        }
+    }
+
+private:
+    struct Entry {
+        size_t hash;
+        uint64_t basis;
+        PolynomType key;
+        PolynomType normal_form;
+    };
+
+    struct Shard {
+        using EntryIterator = typename std::list<Entry>::iterator;
+
+        EntryIterator Find(size_t hash, uint64_t basis, const PolynomType& f) {
+            auto [begin, end] = index.equal_range(hash);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second->basis == basis && it->second->key == f) {
+                    return it->second;
+                }
+            }
+            return entries.end();
+        }
+
+        mutable std::mutex mutex;
+        std::list<Entry> entries;  // the most recently used first
+        std::unordered_multimap<size_t, EntryIterator> index;
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    template <typename Function>
+    size_t Sum(Function function) const {
+        size_t sum = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard lock(shard.mutex);
+            sum += function(shard);
+        }
+        return sum;
+    }
+
+    size_t shard_capacity_;
+    std::array<Shard, kShardsCount> shards_;
+};
+
+}  // namespace groebner_basis
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace groebner_basis {
+
+// Next pair (i, j), j < i, of the Buchberger driver. Every later pair is still pending.
+struct PairCursor {
+    size_t i = 0;
+    size_t j = 0;
+};
+
+// Writes snapshots to a file on its own thread. Only the latest submitted snapshot matters,
+// so a snapshot that was not started yet is replaced by a newer one. The file is replaced
+// atomically: the snapshot goes to "<path>.tmp" first and is renamed when complete.
+class CheckpointWriter {
+public:
+    using Job = std::function<void(std::ostream &)>;
+
+    explicit CheckpointWriter(std::string path) : path_(std::move(path)) {
+        thread_ = std::thread([this] { Loop(); });
+    }
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    ~CheckpointWriter() {
+        Flush();
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    const std::string &GetPath() const {
+        return path_;
+    }
+
+    void Submit(Job job) {
+        {
+            std::lock_guard lock(mutex_);
+            pending_ = std::move(job);
+        }
+        cv_.notify_all();
+    }
+
+    // Waits until every submitted snapshot is on disk
+    void Flush() {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this] { return !pending_ && !busy_; });
+    }
+
+    size_t WrittenCount() const {
+        std::lock_guard lock(mutex_);
+        return written_;
+    }
+
+    bool HasFailed() const {
+        std::lock_guard lock(mutex_);
+        return failed_;
+    }
+
+private:
+    void Loop() {
+
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || pending_; });
+                if (!pending_) {
+                    return;
+                }
+                job = std::move(*pending_);
+                pending_.reset();
+                busy_ = true;
+            }
+
+            bool success = Write(job);
+
+            {
+                std::lock_guard lock(mutex_);
+                busy_ = false;
+                if (success) {
+                    ++written_;
+                } else {
+                    failed_ = true;
+                }
+            }
+            cv_.notify_all();
+        }
+    }
+
+    bool Write(const Job &job) const {
+
+        std::string temp_path = path_ + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            job(file);
+            file.flush();
+            if (!file) {
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp_path, path_, error);
+        return !error;
+    }
+
+    std::string path_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::optional<Job> pending_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    bool failed_ = false;
+    size_t written_ = 0;
+
+    std::thread thread_;
+};
+
+}  // namespace groebner_basis
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include "polynom.h"
+
+namespace groebner_basis {
+
+// Policies of PolynomialsSet. With NoCofactors (the default) nothing is recorded and the set
+// compiles to the same code as without the policy. With TrackCofactors every element of the
+// set remembers how it was obtained from the generators, so it can be written as their
+// combination on request.
+struct NoCofactors {};
+struct TrackCofactors {};
+
+struct CofactorStats {
+    size_t generators = 0;
+    size_t records = 0;
+    size_t steps = 0;        // summands of all records
+    size_t expanded = 0;     // records with computed cofactors
+    size_t memory_bytes = 0; // records, the index of the elements and the computed cofactors
+};
+
+// The history of the elements of a PolynomialsSet<Field, Order, TrackCofactors>. A record is
+// either a generator or a sum of its parts, a part being a term times the polynomial of an
+// earlier record. Only these sums are stored while a basis is built, the cofactors are
+// expanded from them when asked for and then kept for the later requests.
+template <typename Field, typename Order = GrevLexOrder>
+class CofactorRecords {
+public:
+    using PolynomType = Polynom<Field, Order>;
+
+    struct Part {
+        Term<Field> multiplier;
+        uint32_t record;
+    };
+
+    // The record of a new generator, generators are numbered in the order they are added
+    uint32_t AddGenerator(const PolynomType& generator) {
+        records_.push_back({static_cast<uint32_t>(generators_.size()),
+                            static_cast<uint32_t>(parts_.size()), 0});
+        generators_.push_back(generator);
+        return static_cast<uint32_t>(records_.size() - 1);
+    }
+
+    uint32_t AddRecord(const std::vector<Part>& parts) {
+        assert(std::all_of(parts.begin(), parts.end(),
+                           [&](const Part& part) { return part.record < records_.size(); }));
+
+        records_.push_back({kNoGenerator, static_cast<uint32_t>(parts_.size()),
+                            static_cast<uint32_t>(parts.size())});
+        parts_.insert(parts_.end(), parts.begin(), parts.end());
+        return static_cast<uint32_t>(records_.size() - 1);
+    }
+
+    // Polynomials are looked up by value, so f may be any copy of the element
+    void Bind(const PolynomType& f, uint32_t record) {
+        index_.insert_or_assign(f, record);
+    }
+
+    uint32_t Find(const PolynomType& f) const {
+        auto it = index_.find(f);
+        assert(it != index_.end() && "the polynomial was not obtained by the set");
+        return it->second;
+    }
+
+    // Forgets the polynomials which are no longer elements, their records stay
+    template <typename Polynoms>
+    void Retain(const Polynoms& elements) {
+        std::unordered_map<PolynomType, uint32_t> index;
+        for (const auto& f : elements) {
+            index.emplace(f, Find(f));
+        }
+        index_ = std::move(index);
+    }
+
+    const std::vector<PolynomType>& Generators() const {
+        return generators_;
+    }
+
+    // Polynomials c_k with the sum of multiplier * record over parts equal to
+    // sum c_k * Generators()[k]
+    std::vector<PolynomType> Combine(const std::vector<Part>& parts, const Order& order) {
+
+        std::vector<uint32_t> records;
+        records.reserve(parts.size());
+        for (const auto& part : parts) {
+            records.push_back(part.record);
+        }
+        Expand(std::move(records), order);
+
+        std::vector<PolynomType> result(generators_.size(), Zero(order));
+        for (const auto& part : parts) {
+            AddMultiple(result, part.multiplier, expanded_[part.record]);
+        }
+        return result;
+    }
+
+    std::vector<PolynomType> Cofactors(uint32_t record, const Order& order) {
+        return Combine({{Term<Field>(Field(1)), record}}, order);
+    }
+
+    CofactorStats GetStats() const {
+
+        CofactorStats stats;
+        stats.generators = generators_.size();
+        stats.records = records_.size();
+        stats.steps = parts_.size();
+        stats.memory_bytes = records_.capacity() * sizeof(Record) +
+                             parts_.capacity() * sizeof(Part) +
+                             index_.size() * (sizeof(PolynomType) + sizeof(uint32_t) +
+                                              2 * sizeof(void*)) +
+                             index_.bucket_count() * sizeof(void*);
+
+        for (const auto& cofactors : expanded_) {
+            if (cofactors.empty()) {
+                continue;
+            }
+            ++stats.expanded;
+            stats.memory_bytes += cofactors.capacity() * sizeof(PolynomType);
+            for (const auto& c : cofactors) {
+                stats.memory_bytes += c.TermsCount() * sizeof(Term<Field>);
+            }
+        }
+        return stats;
+    }
+
+    void Clear() {
+        records_.clear();
+        parts_.clear();
+        generators_.clear();
+        index_.clear();
+        expanded_.clear();
+    }
+
+private:
+    static constexpr uint32_t kNoGenerator = std::numeric_limits<uint32_t>::max();
+
+    struct Record {
+        uint32_t generator;
+        uint32_t first_part;
+        uint32_t parts_count;
+    };
+
+    static PolynomType Zero(const Order& order) {
+        return PolynomType::BuildFromOrderedTerms({}, order);
+    }
+
+    static void AddMultiple(std::vector<PolynomType>& result, const Term<Field>& multiplier,
+                            const std::vector<PolynomType>& cofactors) {
+        for (size_t k = 0; k < cofactors.size(); ++k) {
+            if (!cofactors[k].IsZero()) {
+                result[k].SubtractMultiple(-multiplier, cofactors[k]);
+            }
+        }
+    }
+
+    // Computes the cofactors of the given records and of everything they depend on. Parts refer
+    // to earlier records, so going by increasing numbers needs no recursion.
+    void Expand(std::vector<uint32_t> pending, const Order& order) {
+
+        expanded_.resize(records_.size());
+        std::vector<uint32_t> missing;
+        while (!pending.empty()) {
+            uint32_t record = pending.back();
+            pending.pop_back();
+            if (!expanded_[record].empty()) {
+                continue;
+            }
+            missing.push_back(record);
+            const Record& current = records_[record];
+            for (uint32_t k = 0; k < current.parts_count; ++k) {
+                pending.push_back(parts_[current.first_part + k].record);
+            }
+        }
+
+        std::sort(missing.begin(), missing.end());
+        missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+        for (auto record : missing) {
+            const Record& current = records_[record];
+            std::vector<PolynomType> cofactors(generators_.size(), Zero(order));
+            if (current.generator != kNoGenerator) {
+                cofactors[current.generator] = PolynomType(Term<Field>(Field(1)), order);
+            }
+            for (uint32_t k = 0; k < current.parts_count; ++k) {
+                const Part& part = parts_[current.first_part + k];
+                AddMultiple(cofactors, part.multiplier, expanded_[part.record]);
+            }
+            expanded_[record] = std::move(cofactors);
+        }
+    }
+
+    std::vector<Record> records_;
+    std::vector<Part> parts_;
+    std::vector<PolynomType> generators_;
+    std::unordered_map<PolynomType, uint32_t> index_;  // the current elements
+    std::vector<std::vector<PolynomType>> expanded_;
+};
+
+}  // namespace groebner_basis
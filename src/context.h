@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include "checkpoint.h"
+#include "monom.h"
+#include "thread_pool.h"
+
+namespace groebner_basis {
+
+enum class ComputationStatus { kCompleted, kCancelled, kDeadlineExceeded, kBudgetExceeded };
+
+class CancellationToken {
+public:
+    void Cancel() {
+        flag_->store(true, std::memory_order_relaxed);
+    }
+
+    bool IsCancelled() const {
+        return flag_->load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class ComputationContext;
+
+    std::shared_ptr<std::atomic<bool>> flag_ = std::make_shared<std::atomic<bool>>(false);
+};
+
+struct Progress {
+    Monom::Degree degree = 0;
+    size_t pending_pairs = 0;
+    size_t basis_size = 0;
+};
+
+// Limits and observers of one long computation. A default constructed context never stops.
+// Once a limit is hit the context remembers the reason and every later check fails too,
+// so nested loops unwind without extra bookkeeping.
+class ComputationContext {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ProgressCallback = std::function<void(const Progress&)>;
+
+    static constexpr size_t kClockCheckStride = 64;
+
+    ComputationContext& SetCancellationToken(const CancellationToken& token) {
+        cancelled_ = token.flag_;
+        return *this;
+    }
+
+    ComputationContext& SetDeadline(Clock::time_point deadline) {
+        deadline_ = deadline;
+        return *this;
+    }
+
+    ComputationContext& SetTimeLimit(Clock::duration limit) {
+        return SetDeadline(Clock::now() + limit);
+    }
+
+    // Upper bound for the number of terms held by the basis and the polynomial being reduced.
+    ComputationContext& SetTermsBudget(size_t terms) {
+        terms_budget_ = terms;
+        return *this;
+    }
+
+    // callback is called once per interval processed pairs
+    ComputationContext& SetProgressCallback(ProgressCallback callback, size_t interval = 64) {
+        progress_callback_ = std::move(callback);
+        progress_interval_ = std::max<size_t>(interval, 1);
+        return *this;
+    }
+
+    // A snapshot of the driver state is handed to writer at most once per interval
+    ComputationContext& SetCheckpointWriter(CheckpointWriter& writer, Clock::duration interval) {
+        checkpoint_writer_ = &writer;
+        checkpoint_interval_ = interval;
+        last_checkpoint_ = Clock::now();
+        return *this;
+    }
+
+    // Parallel phases of the computation run on pool, the others stay on the calling thread
+    ComputationContext& SetThreadPool(ThreadPool& pool) {
+        thread_pool_ = &pool;
+        return *this;
+    }
+
+    ThreadPool* GetThreadPool() const {
+        return thread_pool_;
+    }
+
+    bool ShouldStop(size_t live_terms = 0) {
+
+        if (status_ != ComputationStatus::kCompleted) {
+            return true;
+        }
+
+        if (cancelled_ && cancelled_->load(std::memory_order_relaxed)) {
+            status_ = ComputationStatus::kCancelled;
+        } else if (live_terms > terms_budget_) {
+            status_ = ComputationStatus::kBudgetExceeded;
+        } else if (deadline_ != Clock::time_point::max() && checks_++ % kClockCheckStride == 0 &&
+                   Clock::now() >= deadline_) {
+            status_ = ComputationStatus::kDeadlineExceeded;
+        }
+
+        return status_ != ComputationStatus::kCompleted;
+    }
+
+    ComputationStatus GetStatus() const {
+        return status_;
+    }
+
+    // Called once per processed pair, true when the progress callback wants a report
+    bool IsProgressDue() {
+        if (progress_callback_ && ++pairs_since_report_ >= progress_interval_) {
+            pairs_since_report_ = 0;
+            return true;
+        }
+        return false;
+    }
+
+    void ReportProgress(const Progress& progress) {
+        progress_callback_(progress);
+    }
+
+    bool IsCheckpointDue() {
+        if (!checkpoint_writer_) {
+            return false;
+        }
+
+        auto now = Clock::now();
+        if (now - last_checkpoint_ < checkpoint_interval_) {
+            return false;
+        }
+        last_checkpoint_ = now;
+        return true;
+    }
+
+    CheckpointWriter* GetCheckpointWriter() const {
+        return checkpoint_writer_;
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    Clock::time_point deadline_ = Clock::time_point::max();
+    size_t terms_budget_ = std::numeric_limits<size_t>::max();
+
+    ProgressCallback progress_callback_;
+    size_t progress_interval_ = 1;
+    size_t pairs_since_report_ = 0;
+
+    ThreadPool* thread_pool_ = nullptr;
+
+    CheckpointWriter* checkpoint_writer_ = nullptr;
+    Clock::duration checkpoint_interval_{};
+    Clock::time_point last_checkpoint_;
+
+    size_t checks_ = 0;
+    ComputationStatus status_ = ComputationStatus::kCompleted;
+};
+
+}  // namespace groebner_basis
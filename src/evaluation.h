@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "polynom.h"
+#include "thread_pool.h"
+
+namespace groebner_basis {
+
+// Evaluation of a fixed list of polynomials at many points. The monomials of all polynomials
+// are compiled once into a straight-line program in which every monomial is its prefix (the
+// same monomial with the degree of its last variable lowered by one) times that variable, so
+// shared prefixes are computed once per point. Points are evaluated in blocks of kBlockSize
+// with every instruction applied to the whole block, which keeps the inner loops simple enough
+// to be vectorized by the compiler.
+template <typename Field>
+class Evaluator {
+public:
+    static constexpr size_t kBlockSize = 64;
+
+    template <typename Order>
+    explicit Evaluator(const Polynom<Field, Order>& f) : Evaluator(std::vector{f}) {
+    }
+
+    // polynoms is a PolynomialsSet or any other range of polynomials
+    template <typename Polynoms>
+    explicit Evaluator(const Polynoms& polynoms) {
+
+        std::map<Monom, uint32_t, GrevLexOrder> slots = {{Monom(), 0}};
+        slots_count_ = 1;
+
+        for (const auto& f : polynoms) {
+            for (const auto& t : f) {
+                variables_count_ =
+                    std::max(variables_count_, t.FirstIndexAfterLastNonZeroDegree());
+                terms_.push_back({Compile(t.GetMonom(), slots), t.GetCoefficient()});
+            }
+            offsets_.push_back(terms_.size());
+        }
+    }
+
+    size_t PolynomsCount() const {
+        return offsets_.size();
+    }
+
+    // Number of coordinates of a point
+    size_t VariablesCount() const {
+        return variables_count_;
+    }
+
+    size_t InstructionsCount() const {
+        return program_.size();
+    }
+
+    // Values of every polynomial at point, which has at least VariablesCount() coordinates
+    std::vector<Field> Evaluate(const std::vector<Field>& point) const {
+        assert(point.size() >= variables_count_);
+
+        std::vector<Field> result(PolynomsCount());
+        Scratch scratch;
+        EvaluateBlock(point.data(), point.size(), 0, 1, result, scratch);
+        return result;
+    }
+
+    // points holds VariablesCount() coordinates per point one point after another, the result
+    // holds PolynomsCount() values per point in the same way
+    std::vector<Field> EvaluateBatch(const std::vector<Field>& points) const {
+
+        size_t count = PointsCount(points);
+        std::vector<Field> result(count * PolynomsCount());
+        Scratch scratch;
+        for (size_t begin = 0; begin < count; begin += kBlockSize) {
+            EvaluateBlock(points.data(), variables_count_, begin,
+                          std::min(count, begin + kBlockSize), result, scratch);
+        }
+        return result;
+    }
+
+    std::vector<Field> EvaluateBatch(const std::vector<Field>& points, ThreadPool& pool) const {
+
+        size_t count = PointsCount(points);
+        std::vector<Field> result(count * PolynomsCount());
+        std::vector<Scratch> scratches(pool.Size());
+        size_t blocks = (count + kBlockSize - 1) / kBlockSize;
+
+        pool.ParallelFor(blocks, [&](size_t block, size_t worker) {
+            size_t begin = block * kBlockSize;
+            EvaluateBlock(points.data(), variables_count_, begin,
+                          std::min(count, begin + kBlockSize), result, scratches[worker]);
+        });
+        return result;
+    }
+
+private:
+    // slot target = slot source * x_variable
+    struct Instruction {
+        uint32_t target;
+        uint32_t source;
+        uint32_t variable;
+    };
+
+    struct CompiledTerm {
+        uint32_t slot;
+        Field coefficient;
+    };
+
+    struct Scratch {
+        std::vector<Field> variables;
+        std::vector<Field> values;
+        std::vector<Field> sums;
+    };
+
+    uint32_t Compile(const Monom& monom, std::map<Monom, uint32_t, GrevLexOrder>& slots) {
+
+        auto it = slots.find(monom);
+        if (it != slots.end()) {
+            return it->second;
+        }
+
+        size_t variable = monom.FirstIndexAfterLastNonZeroDegree() - 1;
+        std::vector<Monom::Degree> degrees(monom.begin(), monom.end());
+        --degrees[variable];
+        uint32_t source = Compile(Monom::BuildFromVectorDegrees(degrees), slots);
+
+        uint32_t target = slots_count_++;
+        program_.push_back({target, source, static_cast<uint32_t>(variable)});
+        slots.emplace(monom, target);
+        return target;
+    }
+
+    // Without variables the number of points is unknown, use Evaluate then
+    size_t PointsCount(const std::vector<Field>& points) const {
+        assert(variables_count_ != 0 && points.size() % variables_count_ == 0);
+        return points.size() / variables_count_;
+    }
+
+    // Evaluates points [begin, end), point p starts at points[p * stride]
+    void EvaluateBlock(const Field* points, size_t stride, size_t begin, size_t end,
+                       std::vector<Field>& result, Scratch& scratch) const {
+
+        size_t size = end - begin;
+        auto& variables = scratch.variables;
+        auto& values = scratch.values;
+        auto& sums = scratch.sums;
+        variables.resize(variables_count_ * kBlockSize);
+        values.resize(slots_count_ * kBlockSize);
+        sums.resize(kBlockSize);
+
+        // one row of kBlockSize values per variable and per slot
+        for (size_t p = 0; p < size; ++p) {
+            for (size_t v = 0; v < variables_count_; ++v) {
+                variables[v * kBlockSize + p] = points[(begin + p) * stride + v];
+            }
+        }
+        std::fill(values.begin(), values.begin() + size, Field(1));
+
+        for (const auto& instruction : program_) {
+            Field* target = values.data() + instruction.target * kBlockSize;
+            const Field* source = values.data() + instruction.source * kBlockSize;
+            const Field* variable = variables.data() + instruction.variable * kBlockSize;
+            for (size_t p = 0; p < size; ++p) {
+                target[p] = source[p] * variable[p];
+            }
+        }
+
+        for (size_t f = 0; f < PolynomsCount(); ++f) {
+            std::fill(sums.begin(), sums.begin() + size, Field(0));
+            for (size_t k = f == 0 ? 0 : offsets_[f - 1]; k < offsets_[f]; ++k) {
+                const Field* value = values.data() + terms_[k].slot * kBlockSize;
+                const Field& coefficient = terms_[k].coefficient;
+                for (size_t p = 0; p < size; ++p) {
+                    sums[p] += coefficient * value[p];
+                }
+            }
+            for (size_t p = 0; p < size; ++p) {
+                result[(begin + p) * PolynomsCount() + f] = sums[p];
+            }
+        }
+    }
+
+    std::vector<Instruction> program_;
+    std::vector<CompiledTerm> terms_;
+    std::vector<size_t> offsets_;  // terms_ of polynomial f end at offsets_[f]
+    size_t slots_count_ = 0;
+    size_t variables_count_ = 0;
+};
+
+}  // namespace groebner_basis
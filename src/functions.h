@@ -1,3 +1,5 @@
+#pragma once
+
 #include <cassert>
 #include "polynom.h"
 
@@ -28,4 +30,24 @@ Polynom<Field, Order> SPolynom(const Polynom<Field, Order>& f1, const Polynom<Fi
     return f1 * t1 - f2 * t2;
 }
 
+template <typename Field, typename ToOrder, typename FromOrder>
+Polynom<Field, ToOrder> ChangeOrder(const Polynom<Field, FromOrder>& f, const ToOrder& order) {
+
+    typename Polynom<Field, ToOrder>::Builder builder(order);
+    for (const auto& t : f) {
+        builder.AddTerm(t);
+    }
+    return builder.BuildPolynom();
+}
+
+template <typename Field, typename Order>
+size_t VariablesCount(const Polynom<Field, Order>& f) {
+
+    size_t count = 0;
+    for (const auto& t : f) {
+        count = std::max(count, t.FirstIndexAfterLastNonZeroDegree());
+    }
+    return count;
+}
+
 }  // namespace groebner_basis
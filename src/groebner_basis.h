@@ -1,25 +1,119 @@
+#pragma once
+
+#include <atomic>
 #include <cstddef>
+#include <istream>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
 #include <vector>
+#include "cache.h"
+#include "cofactors.h"
+#include "context.h"
 #include "functions.h"
+#include "rational.h"
+#include "reducer.h"
+#include "special.h"
+#include "trace.h"
+#include "types.h"
 
 namespace groebner_basis {
 
-template <typename Field, typename Order = GrevLexOrder>
+// How S-polynomials are reduced while the basis is built. Only leading terms matter for the
+// algorithm until the end, so by default tails are left as they are and are reduced once
+// in the final interreduction.
+enum class ReductionMode { kTop, kFull };
+
+// CofactorPolicy is NoCofactors or TrackCofactors, see cofactors.h
+template <typename Field, typename Order = GrevLexOrder, typename CofactorPolicy = NoCofactors>
 class PolynomialsSet {
 
     using Polynom = Polynom<Field, Order>;
 
+    static constexpr bool kTracksCofactors = std::is_same_v<CofactorPolicy, TrackCofactors>;
+    // Over fractions the driver keeps the elements primitive until the final interreduction
+    // makes them monic, and top reduces S-polynomials without division
+    static constexpr bool kPseudoReduces = IntegerFractions<Field> && !kTracksCofactors;
+    static constexpr size_t kContentRemovalPeriod = 8;
+    using CofactorPart = typename CofactorRecords<Field, Order>::Part;
+
     using Container = std::vector<Polynom>;
     using Iterator = typename Container::iterator;
     using ConstIterator = typename Container::const_iterator;
 
 public:
-    PolynomialsSet(std::initializer_list<Polynom> poly_list) : data_(poly_list) {
+    PolynomialsSet(std::initializer_list<Polynom> poly_list)
+        : data_(poly_list),
+          order_(data_.empty() ? Order() : data_.front().GetOrder()),
+          order_hash_(HashOrder(order_)) {
+        RehashElements();
+        if constexpr (kTracksCofactors) {
+            RecordGenerators();
+        }
     }
 
     PolynomialsSet() = default;
 
+    explicit PolynomialsSet(const Order &order) : order_(order), order_hash_(HashOrder(order_)) {
+    }
+
+    const Order &GetOrder() const {
+        return order_;
+    }
+
+    void SetReductionMode(ReductionMode mode) {
+        reduction_mode_ = mode;
+    }
+
+    ReductionMode GetReductionMode() const {
+        return reduction_mode_;
+    }
+
+    // Linear, univariate and binomial generators are solved by their own algorithms (see
+    // special.h) unless disabled here. The basis is the same either way.
+    void SetFastPaths(bool enabled) {
+        fast_paths_ = enabled;
+    }
+
+    bool GetFastPaths() const {
+        return fast_paths_;
+    }
+
+    // Reduce and the reductions of S-polynomials look up their remainders in cache first.
+    // The cache may be shared by many sets, also ones used on other threads.
+    void SetNormalFormCache(NormalFormCache<Field, Order> *cache) {
+        cache_ = cache;
+    }
+
+    NormalFormCache<Field, Order> *GetNormalFormCache() const {
+        return cache_;
+    }
+
+    using Workspace = typename Reducer<Field, Order>::Workspace;
+
+    // The tail reductions without a thread pool use workspace instead of a new one, so sets
+    // built one after another on a thread can reuse its memory (see BatchSolver)
+    void SetWorkspace(Workspace *workspace) {
+        workspace_ = workspace;
+    }
+
+    Workspace *GetWorkspace() const {
+        return workspace_;
+    }
+
+    // Hash of the polynomials in their current order. O(1) unless the elements were changed
+    // through iterators since the last build.
+    uint64_t Fingerprint() const {
+        uint64_t elements = elements_hash_.valid ? elements_hash_.value : SumElementHashes();
+        return HashCombine(HashCombine(order_hash_, Size()), elements);
+    }
+
+    // the elements may be changed through the iterator, so the fingerprint is recomputed
     Iterator begin() {  // NOLINT
+        elements_hash_.valid = false;
         return data_.begin();
     }
 
@@ -28,6 +122,7 @@ public:
     }
 
     Iterator end() {  // NOLINT
+        elements_hash_.valid = false;
         return data_.end();
     }
 
@@ -48,64 +143,186 @@ public:
     }
 
     void Add(const Polynom &poly) {
-        if (poly.IsZero()) {
-            return;
+        Append(poly);
+        if constexpr (kTracksCofactors) {
+            if (!poly.IsZero()) {
+                uint32_t generator = cofactors_.AddGenerator(poly);
+                RecordCofactors(data_.back(), {{Term<Field>(Field(1)), generator}},
+                                poly.GetLargestTerm().GetCoefficient());
+            }
         }
-
-        data_.emplace_back(poly);
-        data_.back() =
-            data_.back() * Term<Field>(Field(1) / data_.back().GetLargestTerm().GetCoefficient());
     }
 
     void Add(Polynom &&poly) {
-        if (poly.IsZero()) {
-            return;
+        if constexpr (kTracksCofactors) {
+            Add(poly);  // the generator is kept anyway
+        } else {
+            Append(std::move(poly));
         }
-
-        data_.emplace_back(std::move(poly));
-        data_.back() =
-            data_.back() * Term<Field>(Field(1) / data_.back().GetLargestTerm().GetCoefficient());
     }
 
     void Erase(Iterator it) {
+        cursor_ = PairCursor();
         if (it != data_.end()) {
-            std::swap(*it, data_.back());
+            SwapWithBack(it);
+            ForgetElementHash(Size() - 1);
             data_.pop_back();
         }
     }
 
     void Erase(const Polynom &poly) {
-        auto it = std::find(data_.begin(), data_.end(), poly);
+        size_t hash = poly.Hash();
+        auto it = std::find_if(data_.begin(), data_.end(),
+                               [&](const Polynom &f) { return f.Hash() == hash && f == poly; });
         Erase(it);
     }
 
     void Clear() {
         data_.clear();
+        RehashElements();
+        cursor_ = PairCursor();
+        if constexpr (kTracksCofactors) {
+            cofactors_.Clear();
+        }
     }
 
-    std::optional<Polynom> Reduce(const Polynom &f) const {
+    // Text snapshot of the Buchberger driver: field and order tags, the next pair of
+    // BuildUnReducedGroebnerBasis (all later pairs are pending) and the current polynomials.
+    void SaveCheckpoint(std::ostream &stream) const {
+        WriteCheckpoint(stream, data_, cursor_, order_);
+    }
 
-        std::optional<Polynom> temp = TryReductionForOnePass(f);
-        if (!temp) {
-            return std::nullopt;
+    // Replaces the set with a snapshot written by SaveCheckpoint or by a checkpoint writer.
+    // BuildGreobnerBasis then continues from the saved pair. Returns false (and keeps the set)
+    // if the snapshot is damaged or was taken with another field or order.
+    bool LoadCheckpoint(std::istream &stream) {
+
+        std::string word, field, order;
+        size_t version = 0, size = 0;
+        PairCursor cursor;
+
+        if (!(stream >> word >> version) || word != kCheckpointTag || version != 1) {
+            return false;
+        }
+        if (!ReadLineAfter(stream, "field", field) || field != TypeName<Field>::Get()) {
+            return false;
+        }
+        if (!ReadLineAfter(stream, "order", order) || order != OrderTag(order_)) {
+            return false;
+        }
+        if (!(stream >> word >> cursor.i >> cursor.j) || word != "cursor") {
+            return false;
+        }
+        if (!(stream >> word >> size) || word != "polynomials") {
+            return false;
         }
 
-        Polynom res;
-        while (temp) {
-            res = temp.value();
-            temp = TryReductionForOnePass(res);
+        Container data;
+        data.reserve(size);
+        for (size_t k = 0; k < size; ++k) {
+            size_t terms_count = 0;
+            if (!(stream >> terms_count)) {
+                return false;
+            }
+
+            typename Polynom::Builder builder(order_);
+            for (size_t t = 0; t < terms_count; ++t) {
+                Field coef;
+                size_t degrees_count = 0;
+                if (!(stream >> coef >> degrees_count)) {
+                    return false;
+                }
+
+                std::vector<Monom::Degree> degrees(degrees_count);
+                for (auto &degree : degrees) {
+                    stream >> degree;
+                }
+                builder.AddTerm(coef, Monom::BuildFromVectorDegrees(degrees));
+            }
+
+            if (!stream) {
+                return false;
+            }
+            data.push_back(builder.BuildPolynom());
         }
 
-        return res;
+        if (cursor.j > cursor.i || cursor.i > size) {
+            return false;
+        }
+
+        data_ = std::move(data);
+        RehashElements();
+        cursor_ = cursor;
+        if constexpr (kTracksCofactors) {
+            RecordGenerators();
+        }
+        return true;
+    }
+
+    std::optional<Polynom> Reduce(const Polynom &f) const {
+        ComputationContext context;
+        return Reduce(f, context);
+    }
+
+    // If the context stops the reduction, the partially reduced polynomial is returned
+    std::optional<Polynom> Reduce(const Polynom &f, ComputationContext &context) const {
+        return CachedReduce(f, context, ReductionMode::kFull, [&] {
+            return Reduce(f, context, 0);
+        });
+    }
+
+    // With TrackCofactors: the generators in the order they were added by the constructor,
+    // by Add or by LoadCheckpoint (the snapshot replaces them)
+    const Container &Generators() const requires kTracksCofactors {
+        return cofactors_.Generators();
+    }
+
+    // Polynomials c_k with g = sum c_k * Generators()[k] for an element g of the set
+    Container Cofactors(const Polynom &g) requires kTracksCofactors {
+        return cofactors_.Cofactors(cofactors_.Find(g), order_);
+    }
+
+    // Normal form r of f, cofactors receives polynomials c_k with
+    // f = r + sum c_k * Generators()[k]
+    Polynom ReduceWithCofactors(const Polynom &f, Container &cofactors) requires kTracksCofactors {
+
+        ComputationContext context;
+        std::vector<ReductionStep> steps;
+        auto remainder = ReduceTerms(f, 0, context, 0, &steps);
+
+        std::vector<CofactorPart> parts;
+        for (const auto &step : steps) {
+            parts.push_back({step.quotient, cofactors_.Find(data_[step.reducer])});
+        }
+        cofactors = cofactors_.Combine(parts, order_);
+        return remainder.value_or(f);
+    }
+
+    CofactorStats GetCofactorStats() const requires kTracksCofactors {
+        return cofactors_.GetStats();
     }
 
     void AutoReduction() {
-        auto it = begin();
+        ComputationContext context;
+        AutoReduction(context);
+    }
+
+    void AutoReduction(ComputationContext &context) {
+        auto it = data_.begin();
         for (size_t i = 0; i < Size(); ++i, ++it) {
 
             auto f = *it;
             this->Erase(it);
-            auto temp = this->Reduce(f);
+            std::optional<Polynom> temp;
+            std::conditional_t<kTracksCofactors, std::vector<CofactorPart>, NoCofactors> parts;
+            if constexpr (kTracksCofactors) {
+                std::vector<ReductionStep> steps;
+                temp = ReduceTerms(f, 0, context, 0, &steps);
+                parts.push_back({Term<Field>(Field(1)), cofactors_.Find(f)});
+                AppendSteps(parts, steps);
+            } else {
+                temp = this->Reduce(f, context);
+            }
             if (!temp) {
                 this->AddAt(it, f);
             } else {
@@ -116,44 +333,558 @@ public:
                     i--;
                 }
             }
+            if constexpr (kTracksCofactors) {
+                const Polynom &added = temp ? temp.value() : f;
+                if (!added.IsZero()) {
+                    RecordCofactors(*it, std::move(parts), added.GetLargestTerm().GetCoefficient());
+                }
+            }
+
+            if (context.GetStatus() != ComputationStatus::kCompleted) {
+                break;
+            }
         }
 
-        for (auto &f : (*this)) {
-            f = f * Term<Field>(Field(1) / f.GetLargestTerm().GetCoefficient());
+        for (auto &f : data_) {
+            f.MakeMonic();
+        }
+        RehashElements();
+        if constexpr (kTracksCofactors) {
+            cofactors_.Retain(data_);
         }
     }
 
     void BuildGreobnerBasis() {
+        ComputationContext context;
+        BuildGreobnerBasis(context);
+    }
 
-        BuildUnReducedGroebnerBasis();
-        Minimize();
-        AutoReduction();
-        std::sort(begin(), end());
+    // On early stop the set keeps every polynomial found so far: it generates the same ideal,
+    // but is neither a Groebner basis nor reduced
+    ComputationStatus BuildGreobnerBasis(ComputationContext &context) {
+
+        // a run resumed from a stop or a checkpoint goes on with Buchberger's algorithm
+        if constexpr (!kTracksCofactors) {
+            if (fast_paths_ && cursor_.i == 0 && cursor_.j == 0) {
+                if (auto basis = ReducedBasisOfShape(data_, order_, context)) {
+                    data_ = std::move(basis.value());
+                    SortElements();
+                    return ComputationStatus::kCompleted;
+                }
+                if (context.GetStatus() != ComputationStatus::kCompleted) {
+                    return context.GetStatus();
+                }
+            }
+        }
+        if (!BuildUnReducedGroebnerBasis(context)) {
+            return context.GetStatus();
+        }
+        InterReduce(context);
+        if (context.GetStatus() != ComputationStatus::kCompleted) {
+            return context.GetStatus();
+        }
+        SortElements();
+        return ComputationStatus::kCompleted;
+    }
+
+    // Same as BuildGreobnerBasis(context), and the run is recorded into trace. The trace is
+    // cleared if the computation stops early. S-polynomials are top reduced in any mode.
+    ComputationStatus BuildGreobnerBasis(ComputationContext &context, GroebnerTrace &trace) {
+        assert(cursor_.i == 0 && cursor_.j == 0);
+
+        trace.Clear();
+        for (const auto &f : data_) {
+            trace.input.push_back(Support(f));
+        }
+
+        ReductionMode mode = reduction_mode_;
+        reduction_mode_ = ReductionMode::kTop;
+        trace_ = &trace;
+        bool completed = BuildUnReducedGroebnerBasis(context);
+        trace_ = nullptr;
+        reduction_mode_ = mode;
+
+        if (completed) {
+            Minimize(&trace.survivors);
+            ReduceTails(context);
+        }
+        if (context.GetStatus() != ComputationStatus::kCompleted) {
+            trace.Clear();
+            return context.GetStatus();
+        }
+        SortElements();
+        return ComputationStatus::kCompleted;
+    }
+
+    bool ReplayGroebnerBasis(const GroebnerTrace &trace) {
+        ComputationContext context;
+        return ReplayGroebnerBasis(trace, context);
+    }
+
+    // Builds the basis by following trace, which must come from polynomials with the same
+    // supports. The result is checked to be the reduced Groebner basis of the input: if the
+    // run leaves the trace or the check fails, the basis is built by BuildGreobnerBasis(context)
+    // and false is returned. If the context stops the replay, the input is left as it was.
+    // With TrackCofactors the basis is always built by BuildGreobnerBasis(context).
+    bool ReplayGroebnerBasis(const GroebnerTrace &trace, ComputationContext &context) {
+        assert(cursor_.i == 0 && cursor_.j == 0);
+
+        if constexpr (kTracksCofactors) {
+            BuildGreobnerBasis(context);
+            return false;
+        }
+
+        Container input = data_;
+        if (ReplayUnReduced(trace, context) && ReplaySurvivors(trace)) {
+            ReduceTails(context);
+            if (context.GetStatus() == ComputationStatus::kCompleted && IsReducedBasisOf(input)) {
+                SortElements();
+                return true;
+            }
+        }
+
+        data_ = std::move(input);
+        RehashElements();
+        cursor_ = PairCursor();
+        if (context.GetStatus() == ComputationStatus::kCompleted) {
+            BuildGreobnerBasis(context);
+        }
+        return false;
+    }
+
+    // Number of the variables used by the polynomials (one past the largest index)
+    size_t VariablesCount() const {
+        size_t count = 0;
+        for (const auto &f : data_) {
+            count = std::max(count, groebner_basis::VariablesCount(f));
+        }
+        return count;
+    }
+
+    // Reduced Groebner basis of the elimination ideal: the polynomials of the ideal
+    // without the given variables
+    PolynomialsSet Eliminate(const std::vector<size_t> &variables) const {
+
+        size_t n = VariablesCount();
+        for (auto variable : variables) {
+            n = std::max(n, variable + 1);
+        }
+        EliminationOrder elimination(n, variables);
+        return EliminateFrom(elimination, ToElimination(data_, elimination), variables, *this);
+    }
+
+    // Reduced Groebner basis of the saturation I : f^inf, computed with the Rabinowitsch trick:
+    // I + (1 - t * f) for a new variable t, then t is eliminated. The set's order may not
+    // know t, so the generators are built in the elimination order.
+    PolynomialsSet Saturate(const Polynom &f) const {
+
+        size_t t = std::max(VariablesCount(), groebner_basis::VariablesCount(f));
+        EliminationOrder elimination(t + 1, {t});
+
+        auto generators = ToElimination(data_, elimination);
+        generators.push_back(EliminationPolynom(Term<Field>(Field(1)), elimination) -
+                             ChangeOrder(f, elimination) * VariableTerm(t));
+        return EliminateFrom(elimination, generators, {t}, *this);
+    }
+
+    // Reduced Groebner basis of the intersection of two ideals: t * I + (1 - t) * J
+    // for a new variable t, then t is eliminated
+    static PolynomialsSet Intersect(const PolynomialsSet &first, const PolynomialsSet &second) {
+
+        size_t t = std::max(first.VariablesCount(), second.VariablesCount());
+        EliminationOrder elimination(t + 1, {t});
+
+        std::vector<EliminationPolynom> generators;
+        for (const auto &f : first) {
+            generators.push_back(ChangeOrder(f, elimination) * VariableTerm(t));
+        }
+        for (const auto &g : second) {
+            auto converted = ChangeOrder(g, elimination);
+            generators.push_back(converted - converted * VariableTerm(t));
+        }
+        return EliminateFrom(elimination, generators, {t}, first);
     }
 
 private:
+    template <typename, typename, typename>
+    friend class PolynomialsSet;
+
+    using EliminationPolynom = groebner_basis::Polynom<Field, EliminationOrder>;
+
+    // quotient * data_[reducer] was subtracted
+    struct ReductionStep {
+        Term<Field> quotient;
+        uint32_t reducer;
+    };
+
+    static Term<Field> VariableTerm(size_t variable) {
+        std::vector<Monom::Degree> degrees(variable + 1, 0);
+        degrees[variable] = 1;
+        return Term<Field>(Field(1), Monom::BuildFromVectorDegrees(degrees));
+    }
+
+    static std::vector<EliminationPolynom> ToElimination(const Container &polynoms,
+                                                         const EliminationOrder &elimination) {
+        std::vector<EliminationPolynom> result;
+        result.reserve(polynoms.size());
+        for (const auto &f : polynoms) {
+            result.push_back(ChangeOrder(f, elimination));
+        }
+        return result;
+    }
+
+    static bool ContainsAny(const Polynom &f, const std::vector<size_t> &variables) {
+        return std::any_of(f.begin(), f.end(), [&](const Term<Field> &t) {
+            return std::any_of(variables.begin(), variables.end(),
+                               [&](size_t variable) { return t.Deg(variable) != 0; });
+        });
+    }
+
+    // The unreduced basis in the elimination order already contains a basis of the elimination
+    // ideal, so only its part without the eliminated variables is minimized and interreduced.
+    // The elimination order restricted to the other variables is GrevLex, so for GrevLex
+    // the result needs no further Buchberger run.
+    // settings (order, reduction mode, fast paths) are taken from like
+    static PolynomialsSet EliminateFrom(const EliminationOrder &elimination,
+                                        const std::vector<EliminationPolynom> &generators,
+                                        const std::vector<size_t> &variables,
+                                        const PolynomialsSet &like) {
+
+        const Order &order = like.order_;
+
+        PolynomialsSet<Field, EliminationOrder> full(elimination);
+        full.SetReductionMode(like.reduction_mode_);
+        for (const auto &g : generators) {
+            full.Add(g);
+        }
+
+        ComputationContext context;
+        full.BuildUnReducedGroebnerBasis(context);
+
+        PolynomialsSet result(order);
+        result.SetReductionMode(like.reduction_mode_);
+        result.SetFastPaths(like.fast_paths_);
+        for (const auto &g : full) {
+            if (!PolynomialsSet<Field, EliminationOrder>::ContainsAny(g, variables)) {
+                result.Add(ChangeOrder(g, order));
+            }
+        }
+
+        if constexpr (std::is_same_v<Order, GrevLexOrder>) {
+            result.InterReduce(context);
+            result.SortElements();
+        } else {
+            result.BuildGreobnerBasis();
+        }
+        return result;
+    }
+
+    static constexpr const char *kCheckpointTag = "groebner_basis_checkpoint";
+
+    // orders with runtime state are written together with their parameters
+    static std::string OrderTag(const Order &order) {
+        std::stringstream tag;
+        tag << TypeName<Order>::Get();
+        if constexpr (requires(std::stringstream &stream) { stream << order; }) {
+            tag << " " << order;
+        }
+        return tag.str();
+    }
+
+    static void WriteCheckpoint(std::ostream &stream, const Container &data, PairCursor cursor,
+                                const Order &order) {
+
+        stream << kCheckpointTag << " 1\n";
+        stream << "field " << TypeName<Field>::Get() << "\n";
+        stream << "order " << OrderTag(order) << "\n";
+        stream << "cursor " << cursor.i << " " << cursor.j << "\n";
+        stream << "polynomials " << data.size() << "\n";
+
+        for (const auto &f : data) {
+            stream << f.TermsCount();
+            for (const auto &t : f) {
+                stream << " " << t.GetCoefficient() << " " << t.FirstIndexAfterLastNonZeroDegree();
+                for (auto degree : t.GetMonom()) {
+                    stream << " " << degree;
+                }
+            }
+            stream << "\n";
+        }
+    }
+
+    // type names may contain spaces, so they take the rest of the line
+    static bool ReadLineAfter(std::istream &stream, const std::string &tag, std::string &value) {
+        std::string word;
+        if (!(stream >> word) || word != tag || stream.get() != ' ') {
+            return false;
+        }
+        return static_cast<bool>(std::getline(stream, value));
+    }
+
+    void SubmitCheckpoint(ComputationContext &context) const {
+        context.GetCheckpointWriter()->Submit(
+            [data = data_, cursor = cursor_, order = order_](std::ostream &stream) {
+                WriteCheckpoint(stream, data, cursor, order);
+            });
+    }
+
+    template <typename P>
+    void Append(P &&poly) {
+        if (poly.IsZero()) {
+            return;
+        }
+        assert(IsSameOrder(poly.GetOrder(), order_));
+
+        data_.emplace_back(std::forward<P>(poly));
+        data_.back().MakeMonic();
+        AddElementHash(Size() - 1);
+    }
+
+    // A nonzero remainder of the driver, over fractions it is kept primitive for PseudoSubtract
+    void AppendRemainder(const Polynom &poly) {
+        assert(!poly.IsZero() && IsSameOrder(poly.GetOrder(), order_));
+
+        data_.push_back(poly);
+        if constexpr (kPseudoReduces) {
+            MakePrimitive(data_.back());
+        } else {
+            data_.back().MakeMonic();
+        }
+        AddElementHash(Size() - 1);
+    }
+
     void AddAt(Iterator it, const Polynom &poly) {
-        Add(poly);
+        Append(poly);
+        SwapWithBack(it);
+    }
+
+    // The fingerprint sums the element hashes mixed with their positions, so appending,
+    // erasing and swapping elements update it in O(1). Other changes of the elements
+    // recompute it with RehashElements.
+    struct ElementsHash {
+        uint64_t value = 0;
+        bool valid = true;
+
+        ElementsHash() = default;
+        ElementsHash(const ElementsHash &) = default;
+        ElementsHash &operator=(const ElementsHash &) = default;
+
+        // the elements of a moved-from set are unspecified
+        ElementsHash(ElementsHash &&other) noexcept : value(other.value), valid(other.valid) {
+            other.valid = false;
+        }
+
+        ElementsHash &operator=(ElementsHash &&other) noexcept {
+            value = other.value;
+            valid = other.valid;
+            other.valid = false;
+            return *this;
+        }
+    };
+
+    static uint64_t HashOrder(const Order &order) {
+        return std::hash<std::string>()(OrderTag(order));
+    }
+
+    uint64_t ElementHash(size_t index) const {
+        return HashCombine(data_[index].Hash(), index);
+    }
+
+    uint64_t SumElementHashes() const {
+        uint64_t sum = 0;
+        for (size_t index = 0; index < Size(); ++index) {
+            sum += ElementHash(index);
+        }
+        return sum;
+    }
+
+    void RehashElements() {
+        elements_hash_.value = SumElementHashes();
+        elements_hash_.valid = true;
+    }
+
+    void AddElementHash(size_t index) {
+        if (elements_hash_.valid) {
+            elements_hash_.value += ElementHash(index);
+        }
+    }
+
+    void ForgetElementHash(size_t index) {
+        if (elements_hash_.valid) {
+            elements_hash_.value -= ElementHash(index);
+        }
+    }
+
+    void SwapWithBack(Iterator it) {
+        size_t index = it - data_.begin(), last = Size() - 1;
+        ForgetElementHash(index);
+        ForgetElementHash(last);
         std::swap(*it, data_.back());
+        AddElementHash(index);
+        AddElementHash(last);
     }
 
-    void Minimize() {
+    void SortElements() {
+        std::sort(data_.begin(), data_.end());
+        RehashElements();
+    }
+
+    void RecordGenerators() {
+        cofactors_.Clear();
+        for (const auto &f : data_) {
+            cofactors_.Bind(f, cofactors_.AddGenerator(f));
+        }
+    }
+
+    // Binds the element g which is the sum of parts divided by divisor
+    void RecordCofactors(const Polynom &g, std::vector<CofactorPart> &&parts,
+                         const Field &divisor) {
+        Field inverse = Field(1) / divisor;
+        for (auto &part : parts) {
+            part.multiplier.SetCoefficient(part.multiplier.GetCoefficient() * inverse);
+        }
+
+        const auto &first = parts.front().multiplier;
+        if (parts.size() == 1 && first.GetCoefficient() == Field(1) && first.TotalDegree() == 0) {
+            cofactors_.Bind(g, parts.front().record);
+        } else {
+            cofactors_.Bind(g, cofactors_.AddRecord(parts));
+        }
+    }
+
+    void AppendSteps(std::vector<CofactorPart> &parts,
+                     const std::vector<ReductionStep> &steps) const {
+        for (const auto &step : steps) {
+            parts.push_back({-step.quotient, cofactors_.Find(data_[step.reducer])});
+        }
+    }
+
+    // S-polynomial of data_[i] and data_[j] as in SPolynom
+    std::vector<CofactorPart> SPolynomParts(size_t i, size_t j) const {
+        const auto &first = data_[i].GetLargestTerm();
+        const auto &second = data_[j].GetLargestTerm();
+        auto lcm = LCM(first, second);
+        return {{Term<Field>(second.GetCoefficient(), lcm / first.GetMonom()),
+                 cofactors_.Find(data_[i])},
+                {Term<Field>(-first.GetCoefficient(), lcm / second.GetMonom()),
+                 cofactors_.Find(data_[j])}};
+    }
+
+    // Leaves the elements whose leading monomials are not divisible by the other ones.
+    // A divisor never has a larger degree, so after sorting by degree every element is checked
+    // only against the already kept ones (of equal leading monomials the first is kept).
+    void Minimize(std::vector<uint32_t> *survivors = nullptr) {
+
+        std::vector<size_t> by_degree(Size());
+        std::iota(by_degree.begin(), by_degree.end(), 0);
+        std::stable_sort(by_degree.begin(), by_degree.end(), [this](size_t a, size_t b) {
+            return data_[a].GetLargestTerm().TotalDegree() <
+                   data_[b].GetLargestTerm().TotalDegree();
+        });
+
+        std::vector<char> keep(Size(), false);
+        std::vector<std::pair<uint64_t, Monom>> kept_leading;
 
-        for (auto it1 = begin(); it1 != end(); ++it1) {
-            bool remove = false;
-            std::swap(*it1, *begin());
+        for (auto index : by_degree) {
+            const Monom &leading = data_[index].GetLargestTerm();
+            uint64_t mask = leading.DivisibilityMask();
 
-            for (auto it2 = begin() + 1; it2 != end(); ++it2) {
-                if (data_.front().GetLargestTerm().IsDivisibleBy(it2->GetLargestTerm())) {
-                    remove = true;
+            bool divisible = std::any_of(kept_leading.begin(), kept_leading.end(),
+                                         [&](const auto &kept) {
+                                             return (kept.first & ~mask) == 0 &&
+                                                    leading.IsDivisibleBy(kept.second);
+                                         });
+            if (!divisible) {
+                keep[index] = true;
+                kept_leading.emplace_back(mask, leading);
+            }
+        }
+
+        Container minimal;
+        minimal.reserve(kept_leading.size());
+        for (size_t i = 0; i < Size(); ++i) {
+            if (keep[i]) {
+                minimal.push_back(std::move(data_[i]));
+                if (survivors) {
+                    survivors->push_back(i);
                 }
             }
+        }
+        data_ = std::move(minimal);
+        RehashElements();
+        cursor_ = PairCursor();
+    }
+
+    // Turns a Groebner basis into the reduced one. After Minimize the leading terms are fixed,
+    // so every tail is reduced independently against the same leading terms, in parallel when
+    // the context has a thread pool. The reduced basis is unique, so the result does not
+    // depend on the order in which the elements are processed.
+    void InterReduce(ComputationContext &context) {
+        Minimize();
+        ReduceTails(context);
+    }
+
+    void ReduceTails(ComputationContext &context) {
+
+        // every step refers to the current record of its reducer, so the elements are
+        // reduced one by one
+        if constexpr (kTracksCofactors) {
+            for (size_t i = 0; i < Size() && !context.ShouldStop(); ++i) {
+                std::vector<ReductionStep> steps;
+                auto tail = ReduceTerms(data_[i], 1, context, 0, &steps);
+                Polynom f = tail.value_or(data_[i]);
+                Field leading = f.GetLargestTerm().GetCoefficient();
+                if (!tail && leading == Field(1)) {
+                    continue;
+                }
+
+                std::vector<CofactorPart> parts = {
+                    {Term<Field>(Field(1)), cofactors_.Find(data_[i])}};
+                AppendSteps(parts, steps);
+                f.MakeMonic();
+                data_[i] = std::move(f);
+                RecordCofactors(data_[i], std::move(parts), leading);
+            }
+            cofactors_.Retain(data_);
+            RehashElements();
+            return;
+        }
+
+        Reducer<Field, Order> reducer(*this);
+
+        auto reduce = [&](size_t index, Workspace &workspace) {
+            auto &f = data_[index];
+            f = reducer.ReduceTail(f, workspace);
+            f.MakeMonic();
+        };
 
-            if (remove) {
-                Erase(begin());
-                it1--;
+        if (ThreadPool *pool = context.GetThreadPool()) {
+            // the context is not thread safe, so the workers check it one at a time and skip
+            // the remaining elements once it stops
+            std::mutex context_mutex;
+            std::atomic<bool> stopped = false;
+            std::vector<Workspace> workspaces(pool->Size());
+            pool->ParallelFor(Size(), [&](size_t index, size_t worker) {
+                if (stopped.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                {
+                    std::lock_guard lock(context_mutex);
+                    if (context.ShouldStop()) {
+                        stopped.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+                reduce(index, workspaces[worker]);
+            });
+        } else {
+            Workspace local;
+            Workspace &workspace = workspace_ ? *workspace_ : local;
+            for (size_t i = 0; i < Size() && !context.ShouldStop(); ++i) {
+                reduce(i, workspace);
             }
         }
+        RehashElements();
     }
 
     std::optional<Polynom> TryReductionForOnePass(const Polynom &f) const {
@@ -177,28 +908,368 @@ private:
         return res;
     }
 
-    void BuildUnReducedGroebnerBasis() {
+    std::optional<Polynom> Reduce(const Polynom &f, ComputationContext &context,
+                                  size_t basis_terms) const {
 
-        for (size_t i = 0; i < Size(); ++i) {
-            for (size_t j = 0; j < i; ++j) {
-                auto s = SPolynom(data_[i], data_[j]);
+        std::optional<Polynom> temp = TryReductionForOnePass(f);
+        if (!temp) {
+            return std::nullopt;
+        }
+
+        Polynom res;
+        while (temp) {
+            res = temp.value();
+            if (context.ShouldStop(basis_terms + res.TermsCount())) {
+                break;
+            }
+            temp = TryReductionForOnePass(res);
+        }
+
+        return res;
+    }
+
+    // Reduces the terms of f from the term number first on (1 leaves the leading term) until
+    // none of them is divisible by a leading term of the set, std::nullopt if nothing changes.
+    // The steps are appended to steps if it is given
+    std::optional<Polynom> ReduceTerms(const Polynom &f, size_t first, ComputationContext &context,
+                                       size_t basis_terms,
+                                       std::vector<ReductionStep> *steps = nullptr) const {
+
+        std::optional<Polynom> res;
+        const Polynom *current = &f;
+
+        // the terms before position are irreducible and stay so after every subtraction
+        for (size_t position = first; position < current->TermsCount();) {
+            const auto &t = *(current->begin() + position);
+            auto g = std::find_if(begin(), end(), [&](const Polynom &g) {
+                return t.IsDivisibleBy(g.GetLargestTerm());
+            });
+            if (g == end()) {
+                ++position;
+                continue;
+            }
+
+            Term<Field> quotient = t / g->GetLargestTerm();
+            if (steps) {
+                steps->push_back({quotient, static_cast<uint32_t>(g - begin())});
+            }
+            if (!res) {
+                res = f;
+            }
+            res->SubtractMultiple(quotient, *g);
+            current = &res.value();
+            if (context.ShouldStop(basis_terms + current->TermsCount())) {
+                break;
+            }
+        }
+
+        return res;
+    }
+
+    // Reduces only the leading term until it is not divisible by any leading term of the set
+    // The steps are appended to steps if it is given. Without steps over fractions the result
+    // is the remainder times a constant (fraction-free pseudo-reduction).
+    std::optional<Polynom> TopReduce(const Polynom &f, ComputationContext &context,
+                                     size_t basis_terms,
+                                     std::vector<ReductionStep> *steps = nullptr) const {
+
+        std::optional<Polynom> res;
+        const Polynom *current = &f;
+        size_t pseudo_steps = 0;
 
-                if (s.IsZero()) {
+        while (!current->IsZero()) {
+            const auto &leading = current->GetLargestTerm();
+            auto g = std::find_if(begin(), end(), [&](const Polynom &g) {
+                return leading.IsDivisibleBy(g.GetLargestTerm());
+            });
+            if (g == end()) {
+                break;
+            }
+
+            if constexpr (kPseudoReduces) {
+                if (!steps) {
+                    if (!res) {
+                        res = f;  // integral, an S-polynomial of primitive elements
+                    }
+                    PseudoSubtract(res.value(), *g);
+                    if (++pseudo_steps % kContentRemovalPeriod == 0) {
+                        MakePrimitive(res.value());
+                    }
+                    current = &res.value();
+                    if (context.ShouldStop(basis_terms + current->TermsCount())) {
+                        break;
+                    }
                     continue;
                 }
+            }
 
-                auto r_ij = Reduce(s);
+            Term<Field> quotient = leading / g->GetLargestTerm();
+            if (steps) {
+                steps->push_back({quotient, static_cast<uint32_t>(g - begin())});
+            }
+            if (!res) {
+                res = f;  // shares the terms of f until the first subtraction
+            }
+            res->SubtractMultiple(quotient, *g);
+            current = &res.value();
+            if (context.ShouldStop(basis_terms + current->TermsCount())) {
+                break;
+            }
+        }
 
-                if (!r_ij) {
-                    Add(s);
-                } else if (!r_ij.value().IsZero()) {
-                    Add(r_ij.value());
+        return res;
+    }
+
+    bool BuildUnReducedGroebnerBasis(ComputationContext &context) {
+
+        size_t basis_terms = 0;
+        for (auto &f : data_) {
+            basis_terms += f.TermsCount();
+            if constexpr (kPseudoReduces) {
+                MakePrimitive(f);  // also the elements given to the constructor
+            }
+        }
+        RehashElements();
+
+        // the loops run on cursor_, so a stopped computation or a loaded checkpoint resumes
+        // exactly at the first unprocessed pair
+        for (; cursor_.i < Size(); ++cursor_.i, cursor_.j = 0) {
+            for (; cursor_.j < cursor_.i; ++cursor_.j) {
+                size_t i = cursor_.i, j = cursor_.j;
+
+                if (context.IsCheckpointDue()) {
+                    SubmitCheckpoint(context);
                 }
+
+                if (context.ShouldStop(basis_terms)) {
+                    if (context.GetCheckpointWriter()) {
+                        SubmitCheckpoint(context);
+                    }
+                    return false;
+                }
+
+                auto s = SPolynom(data_[i], data_[j]);
+
+                if (!s.IsZero()) {
+                    size_t size = Size();
+                    std::vector<ReductionStep> steps;
+                    auto r_ij = trace_ || kTracksCofactors
+                                    ? RecordedReduce(s, context, basis_terms, steps)
+                                    : CachedReduce(s, context, reduction_mode_, [&] {
+                                             return reduction_mode_ == ReductionMode::kTop
+                                                        ? TopReduce(s, context, basis_terms)
+                                                        : Reduce(s, context, basis_terms);
+                                         });
+                    if (context.GetStatus() != ComputationStatus::kCompleted) {
+                        if (context.GetCheckpointWriter()) {
+                            SubmitCheckpoint(context);
+                        }
+                        return false;
+                    }
+
+                    if (!r_ij) {
+                        basis_terms += s.TermsCount();
+                        AppendRemainder(s);
+                    } else if (!r_ij.value().IsZero()) {
+                        basis_terms += r_ij.value().TermsCount();
+                        AppendRemainder(r_ij.value());
+                    }
+
+                    if (trace_ && data_.size() > size) {
+                        RecordPair(i, j, steps);
+                    }
+                    if constexpr (kTracksCofactors) {
+                        if (data_.size() > size) {
+                            auto parts = SPolynomParts(i, j);
+                            AppendSteps(parts, steps);
+                            const Polynom &remainder = r_ij ? r_ij.value() : s;
+                            RecordCofactors(data_.back(), std::move(parts),
+                                            remainder.GetLargestTerm().GetCoefficient());
+                        }
+                    }
+                }
+
+                if (context.IsProgressDue()) {
+                    context.ReportProgress(
+                        {PairDegree(i, j), PairsCount() - (i * (i - 1) / 2 + j) - 1, Size()});
+                }
+            }
+        }
+
+        cursor_ = PairCursor();
+        return true;
+    }
+
+    // Reduction of an S-polynomial in the current mode with its steps written out
+    std::optional<Polynom> RecordedReduce(const Polynom &s, ComputationContext &context,
+                                          size_t basis_terms,
+                                          std::vector<ReductionStep> &steps) const {
+        return reduction_mode_ == ReductionMode::kTop
+                   ? TopReduce(s, context, basis_terms, &steps)
+                   : ReduceTerms(s, 0, context, basis_terms, &steps);
+    }
+
+    // the last element is the remainder of the pair (i, j) after steps
+    void RecordPair(size_t i, size_t j, const std::vector<ReductionStep> &steps) {
+        GroebnerTrace::Pair pair{static_cast<uint32_t>(i), static_cast<uint32_t>(j), {},
+                                 data_.back().GetLargestTerm().GetMonom()};
+        for (const auto &step : steps) {
+            const auto &reducer = data_[step.reducer].GetLargestTerm();
+            pair.steps.push_back({step.quotient.GetMonom() * reducer.GetMonom(), step.reducer});
+        }
+        trace_->pairs.push_back(std::move(pair));
+    }
+
+    // Runs reduce (which returns std::nullopt if f is irreducible) unless the cache knows
+    // the remainder of f in the given mode. Remainders of stopped reductions are not cached.
+    template <typename Reduction>
+    std::optional<Polynom> CachedReduce(const Polynom &f, ComputationContext &context,
+                                        ReductionMode mode, Reduction &&reduce) const {
+        if (!cache_) {
+            return reduce();
+        }
+
+        uint64_t basis = HashCombine(Fingerprint(), static_cast<size_t>(mode));
+        if (auto remainder = cache_->Find(basis, f)) {
+            if (*remainder == f) {
+                return std::nullopt;
             }
+            return remainder;
+        }
+
+        auto remainder = reduce();
+        if (context.GetStatus() == ComputationStatus::kCompleted) {
+            cache_->Insert(basis, f, remainder.value_or(f));
+        }
+        return remainder;
+    }
+
+    static std::vector<Monom> Support(const Polynom &f) {
+        std::vector<Monom> support;
+        support.reserve(f.TermsCount());
+        for (const auto &t : f) {
+            support.push_back(t.GetMonom());
         }
+        return support;
+    }
+
+    static bool HasSupport(const Polynom &f, const std::vector<Monom> &support) {
+        return std::equal(f.begin(), f.end(), support.begin(), support.end(),
+                          [](const Term<Field> &t, const Monom &m) { return t.GetMonom() == m; });
+    }
+
+    // Adds the remainders of the recorded pairs. False if a remainder or a reduction step
+    // differs from the trace.
+    bool ReplayUnReduced(const GroebnerTrace &trace, ComputationContext &context) {
+
+        if (trace.input.size() != Size()) {
+            return false;
+        }
+        for (size_t k = 0; k < Size(); ++k) {
+            if (!HasSupport(data_[k], trace.input[k])) {
+                return false;
+            }
+        }
+
+        for (const auto &pair : trace.pairs) {
+            if (pair.j >= pair.i || pair.i >= Size() || context.ShouldStop()) {
+                return false;
+            }
+
+            auto s = SPolynom(data_[pair.i], data_[pair.j]);
+            for (const auto &step : pair.steps) {
+                if (step.reducer >= Size() || s.IsZero() ||
+                    s.GetLargestTerm().GetMonom() != step.leading ||
+                    !step.leading.IsDivisibleBy(data_[step.reducer].GetLargestTerm())) {
+                    return false;
+                }
+                const Polynom &g = data_[step.reducer];
+                Term<Field> quotient = s.GetLargestTerm() / g.GetLargestTerm();
+                s.SubtractMultiple(quotient, g);
+            }
+
+            if (s.IsZero() || s.GetLargestTerm().GetMonom() != pair.result) {
+                return false;
+            }
+            Append(std::move(s));
+        }
+        return true;
+    }
+
+    bool ReplaySurvivors(const GroebnerTrace &trace) {
+
+        Container minimal;
+        minimal.reserve(trace.survivors.size());
+        for (auto index : trace.survivors) {
+            if (index >= Size()) {
+                return false;
+            }
+            minimal.push_back(std::move(data_[index]));
+        }
+        data_ = std::move(minimal);
+        RehashElements();
+        return true;
+    }
+
+    // Whether the set is the reduced Groebner basis of the ideal generated by input, given that
+    // it lies in that ideal and its tails are reduced. Pairs with coprime leading monomials
+    // are skipped by Buchberger's first criterion.
+    bool IsReducedBasisOf(const Container &input) const {
+
+        for (size_t i = 0; i < Size(); ++i) {
+            for (size_t j = 0; j < Size(); ++j) {
+                if (i != j && data_[i].GetLargestTerm().IsDivisibleBy(data_[j].GetLargestTerm())) {
+                    return false;
+                }
+            }
+        }
+
+        Reducer<Field, Order> reducer(*this);
+        Workspace local;
+        Workspace &workspace = workspace_ ? *workspace_ : local;
+
+        for (const auto &f : input) {
+            if (!reducer.IsMember(f, workspace)) {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < Size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                const Monom &a = data_[i].GetLargestTerm();
+                const Monom &b = data_[j].GetLargestTerm();
+                if (LCM(a, b).TotalDegree() == a.TotalDegree() + b.TotalDegree()) {
+                    continue;
+                }
+                if (!reducer.IsMember(SPolynom(data_[i], data_[j]), workspace)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    Monom::Degree PairDegree(size_t i, size_t j) const {
+        auto lcm = LCM(data_[i].GetLargestTerm(), data_[j].GetLargestTerm());
+        return std::accumulate(lcm.begin(), lcm.end(), Monom::Degree(0));
+    }
+
+    size_t PairsCount() const {
+        return Size() * (Size() - 1) / 2;
     }
 
     Container data_;
+    PairCursor cursor_;
+    ReductionMode reduction_mode_ = ReductionMode::kTop;
+    bool fast_paths_ = true;
+    GroebnerTrace *trace_ = nullptr;  // the run being recorded
+    NormalFormCache<Field, Order> *cache_ = nullptr;
+    Workspace *workspace_ = nullptr;
+    [[no_unique_address]] std::conditional_t<kTracksCofactors, CofactorRecords<Field, Order>,
+                                             NoCofactors> cofactors_;
+    [[no_unique_address]] Order order_;
+    uint64_t order_hash_ = HashOrder(order_);
+    ElementsHash elements_hash_;
 };
 
 }  // namespace groebner_basis
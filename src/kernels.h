@@ -0,0 +1,306 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "types.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace groebner_basis {
+
+// Kernels for coefficient arrays modulo a prime p < 2^31, stored as uint32_t residues in [0, p).
+// The AVX2 or SSE4.1 versions are used when the compiler targets them, otherwise the scalar
+// loops below do the same job.
+
+// Multiplication by a fixed residue w without division (Shoup): the quotient of a * w by p
+// is taken from the precomputed floor(w * 2^32 / p) and is off by at most one.
+class ShoupMultiplier {
+public:
+    ShoupMultiplier(uint32_t w, uint32_t p)
+        : w_(w), w_shoup_(static_cast<uint32_t>((static_cast<uint64_t>(w) << 32) / p)), p_(p) {
+        assert(p < (1u << 31) && w < p);
+    }
+
+    // a < p
+    uint32_t operator()(uint32_t a) const {
+        uint32_t q = static_cast<uint32_t>((static_cast<uint64_t>(a) * w_shoup_) >> 32);
+        uint32_t r = a * w_ - q * p_;
+        return r >= p_ ? r - p_ : r;
+    }
+
+    uint32_t GetW() const {
+        return w_;
+    }
+
+    uint32_t GetWShoup() const {
+        return w_shoup_;
+    }
+
+    uint32_t GetModulus() const {
+        return p_;
+    }
+
+private:
+    uint32_t w_;
+    uint32_t w_shoup_;
+    uint32_t p_;
+};
+
+namespace simd {
+
+struct Scalar {
+    static constexpr size_t kWidth = 1;
+};
+
+#if defined(__SSE4_1__)
+struct Sse41 {
+    using Vector = __m128i;
+    static constexpr size_t kWidth = 4;
+    static constexpr size_t kWideWidth = 2;
+
+    static Vector Load(const uint32_t* data) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    static void Store(uint32_t* data, Vector v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), v);
+    }
+
+    static Vector Set(uint32_t value) {
+        return _mm_set1_epi32(static_cast<int>(value));
+    }
+
+    // a * w mod p for every lane, w_shoup and p broadcast
+    static Vector MulShoup(Vector a, Vector w, Vector w_shoup, Vector p) {
+        Vector q_even = _mm_srli_epi64(_mm_mul_epu32(a, w_shoup), 32);
+        Vector q_odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), w_shoup);
+        Vector q = _mm_blend_epi16(q_even, q_odd, 0xCC);
+        Vector r = _mm_sub_epi32(_mm_mullo_epi32(a, w), _mm_mullo_epi32(q, p));
+        return _mm_min_epu32(r, _mm_sub_epi32(r, p));
+    }
+
+    // a + b mod p for a, b < p
+    static Vector AddMod(Vector a, Vector b, Vector p) {
+        Vector s = _mm_add_epi32(a, b);
+        return _mm_min_epu32(s, _mm_sub_epi32(s, p));
+    }
+
+    // acc[i] += c * x[i] for kWideWidth lanes of 64 bits
+    static void MulAddWide(uint64_t* acc, const uint32_t* x, Vector c) {
+        Vector wide = _mm_cvtepu32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x)));
+        Vector sum = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(acc)),
+                                   _mm_mul_epu32(wide, c));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc), sum);
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+struct Avx2 {
+    using Vector = __m256i;
+    static constexpr size_t kWidth = 8;
+    static constexpr size_t kWideWidth = 4;
+
+    static Vector Load(const uint32_t* data) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    }
+
+    static void Store(uint32_t* data, Vector v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), v);
+    }
+
+    static Vector Set(uint32_t value) {
+        return _mm256_set1_epi32(static_cast<int>(value));
+    }
+
+    static Vector MulShoup(Vector a, Vector w, Vector w_shoup, Vector p) {
+        Vector q_even = _mm256_srli_epi64(_mm256_mul_epu32(a, w_shoup), 32);
+        Vector q_odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), w_shoup);
+        Vector q = _mm256_blend_epi32(q_even, q_odd, 0xAA);
+        Vector r = _mm256_sub_epi32(_mm256_mullo_epi32(a, w), _mm256_mullo_epi32(q, p));
+        return _mm256_min_epu32(r, _mm256_sub_epi32(r, p));
+    }
+
+    static Vector AddMod(Vector a, Vector b, Vector p) {
+        Vector s = _mm256_add_epi32(a, b);
+        return _mm256_min_epu32(s, _mm256_sub_epi32(s, p));
+    }
+
+    static void MulAddWide(uint64_t* acc, const uint32_t* x, Vector c) {
+        Vector wide = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x)));
+        Vector sum = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc)),
+                                      _mm256_mul_epu32(wide, c));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), sum);
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+using Native = Avx2;
+#elif defined(__SSE4_1__)
+using Native = Sse41;
+#else
+using Native = Scalar;
+#endif
+
+}  // namespace simd
+
+// y[i] = y[i] + c * x[i] mod p
+template <typename Simd = simd::Native>
+void AxpyMod(uint32_t* y, const uint32_t* x, size_t size, uint32_t c, uint32_t p) {
+
+    ShoupMultiplier multiplier(c, p);
+    size_t i = 0;
+
+    if constexpr (Simd::kWidth > 1) {
+        auto w = Simd::Set(c);
+        auto w_shoup = Simd::Set(multiplier.GetWShoup());
+        auto modulus = Simd::Set(p);
+        for (; i + Simd::kWidth <= size; i += Simd::kWidth) {
+            auto product = Simd::MulShoup(Simd::Load(x + i), w, w_shoup, modulus);
+            Simd::Store(y + i, Simd::AddMod(Simd::Load(y + i), product, modulus));
+        }
+    }
+
+    for (; i < size; ++i) {
+        uint32_t s = y[i] + multiplier(x[i]);
+        y[i] = s >= p ? s - p : s;
+    }
+}
+
+// y[i] = c * y[i] mod p
+template <typename Simd = simd::Native>
+void ScaleMod(uint32_t* y, size_t size, uint32_t c, uint32_t p) {
+
+    ShoupMultiplier multiplier(c, p);
+    size_t i = 0;
+
+    if constexpr (Simd::kWidth > 1) {
+        auto w = Simd::Set(c);
+        auto w_shoup = Simd::Set(multiplier.GetWShoup());
+        auto modulus = Simd::Set(p);
+        for (; i + Simd::kWidth <= size; i += Simd::kWidth) {
+            Simd::Store(y + i, Simd::MulShoup(Simd::Load(y + i), w, w_shoup, modulus));
+        }
+    }
+
+    for (; i < size; ++i) {
+        y[i] = multiplier(y[i]);
+    }
+}
+
+// A dense row kept in 64-bit lanes for a sequence of row operations. Products are added
+// without reduction and the row is reduced only when the next product could overflow,
+// which for p close to 2^30 happens once per 16 operations and almost never for small p.
+template <typename Simd = simd::Native>
+class DenseRowAccumulator {
+public:
+    DenseRowAccumulator(size_t size, uint32_t p) : row_(size), p_(p) {
+        assert(p > 1 && p < (1u << 31));
+        uint64_t max_product = static_cast<uint64_t>(p - 1) * (p - 1);
+        max_pending_ = (std::numeric_limits<uint64_t>::max() - (p - 1)) / max_product;
+    }
+
+    size_t Size() const {
+        return row_.size();
+    }
+
+    void Assign(const uint32_t* row) {
+        for (size_t i = 0; i < row_.size(); ++i) {
+            row_[i] = row[i];
+        }
+        pending_ = 0;
+    }
+
+    // row += c * x
+    void AddMultiple(const uint32_t* x, uint32_t c) {
+
+        if (pending_ == max_pending_) {
+            Reduce();
+        }
+        ++pending_;
+
+        size_t i = 0;
+        if constexpr (Simd::kWidth > 1) {
+            auto factor = Simd::Set(c);
+            for (; i + Simd::kWideWidth <= row_.size(); i += Simd::kWideWidth) {
+                Simd::MulAddWide(row_.data() + i, x + i, factor);
+            }
+        }
+
+        for (; i < row_.size(); ++i) {
+            row_[i] += static_cast<uint64_t>(c) * x[i];
+        }
+    }
+
+    // row -= c * x
+    void SubtractMultiple(const uint32_t* x, uint32_t c) {
+        AddMultiple(x, c == 0 ? 0 : p_ - c);
+    }
+
+    // Writes the reduced row
+    void Extract(uint32_t* row) {
+        Reduce();
+        for (size_t i = 0; i < row_.size(); ++i) {
+            row[i] = static_cast<uint32_t>(row_[i]);
+        }
+    }
+
+private:
+    void Reduce() {
+        for (auto& value : row_) {
+            value %= p_;
+        }
+        pending_ = 0;
+    }
+
+    std::vector<uint64_t> row_;
+    uint32_t p_;
+    uint64_t max_pending_ = 0;
+    uint64_t pending_ = 0;
+};
+
+// Modulus stored in 32 bits with p < 2^31 has the layout of the uint32_t arrays above
+template <typename Field>
+struct IsSmallPrimeField : std::false_type {};
+
+template <typename T, T Tmod>
+struct IsSmallPrimeField<Modulus<T, Tmod>>
+    : std::bool_constant<sizeof(T) == sizeof(uint32_t) &&
+                         static_cast<uint64_t>(Tmod) < (uint64_t(1) << 31)> {};
+
+// y += c * x for arrays of field elements
+template <typename Field>
+void Axpy(Field* y, const Field* x, size_t size, const Field& c) {
+
+    if constexpr (IsSmallPrimeField<Field>::value) {
+        AxpyMod(reinterpret_cast<uint32_t*>(y), reinterpret_cast<const uint32_t*>(x), size,
+                static_cast<uint32_t>(c.GetValue()), static_cast<uint32_t>(Field::kModulus));
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            y[i] += c * x[i];
+        }
+    }
+}
+
+// y *= c for arrays of field elements
+template <typename Field>
+void Scale(Field* y, size_t size, const Field& c) {
+
+    if constexpr (IsSmallPrimeField<Field>::value) {
+        ScaleMod(reinterpret_cast<uint32_t*>(y), size, static_cast<uint32_t>(c.GetValue()),
+                 static_cast<uint32_t>(Field::kModulus));
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            y[i] *= c;
+        }
+    }
+}
+
+}  // namespace groebner_basis
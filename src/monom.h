@@ -1,15 +1,23 @@
+#pragma once
+
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <vector>
 #include <initializer_list>
 #include <type_traits>
 
 namespace groebner_basis {
 
+inline size_t HashCombine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
 template <typename Iterator, typename T>
 concept IsIteratorValueEqualsT =
     std::is_same_v<T, typename std::iterator_traits<Iterator>::value_type>;
@@ -76,6 +84,34 @@ public:
         return degrees_->size();
     }
 
+    Degree TotalDegree() const {
+        return std::accumulate(degrees_->begin(), degrees_->end(), Degree(0));
+    }
+
+    // Bit i is set if some variable with index i modulo 64 is present. If a monomial is
+    // divisible by another one, its mask contains the mask of the divisor.
+    uint64_t DivisibilityMask() const {
+        uint64_t mask = 0;
+        for (auto it = begin(); it != end(); ++it) {
+            if (*it) {
+                mask |= uint64_t(1) << ((it - begin()) % 64);
+            }
+        }
+        return mask;
+    }
+
+    size_t Hash() const {
+        size_t hash = degrees_->size();
+        for (auto degree : *degrees_) {
+            hash = HashCombine(hash, degree);
+        }
+        return hash;
+    }
+
+    size_t CountSignificantDegrees() const {
+        return degrees_->size() - std::count(degrees_->begin(), degrees_->end(), Degree(0));
+    }
+
     Monom operator/(const Monom& other) const {
 
         assert(IsDivisibleBy(other));
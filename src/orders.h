@@ -1,10 +1,19 @@
+#pragma once
+
 #include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <memory>
 #include <numeric>
+#include <vector>
 #include "monom.h"
 
 namespace groebner_basis {
 class LexOrder {
 public:
+    static constexpr const char *kName = "lex";
+
     bool operator()(const Monom &a, const Monom &b) const {
         return std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end());
     }
@@ -12,6 +21,8 @@ public:
 
 class RevLexOrder {
 public:
+    static constexpr const char *kName = "revlex";
+
     bool operator()(const Monom &a, const Monom &b) const {
 
         if (a.FirstIndexAfterLastNonZeroDegree() != b.FirstIndexAfterLastNonZeroDegree()) {
@@ -24,6 +35,8 @@ public:
 
 class GrLexOrder {
 public:
+    static constexpr const char *kName = "grlex";
+
     bool operator()(const Monom &a, const Monom &b) const {
         Monom::Degree sum1 = std::accumulate(a.begin(), a.end(), 0),
                       sum2 = std::accumulate(b.begin(), b.end(), 0);
@@ -36,6 +49,8 @@ public:
 
 class GrevLexOrder {
 public:
+    static constexpr const char *kName = "grevlex";
+
     bool operator()(const Monom &a, const Monom &b) const {
         Monom::Degree sum1 = std::accumulate(a.begin(), a.end(), 0),
                       sum2 = std::accumulate(b.begin(), b.end(), 0);
@@ -46,4 +61,227 @@ public:
     }
 };
 
+// Order given by an integer matrix M over a fixed number of variables: a monomial with degrees
+// e has the key M * e, and keys are compared lexicographically, the larger one first.
+// Polynom computes the key of every term once and keeps it next to the term; the key of a
+// product is the sum of the keys. Comparing bare monomials computes the rows one by one and
+// stops at the first difference. M must have full column rank, so equal keys mean equal
+// monomials, and the first nonzero entry of every column must be positive.
+class MatrixOrder {
+public:
+    static constexpr const char *kName = "matrix";
+
+    MatrixOrder() = default;  // without rows; only to be assigned, it cannot compare monomials
+
+    explicit MatrixOrder(const std::vector<std::vector<std::int64_t>> &rows)
+        : columns_(rows.empty() ? 0 : rows.front().size()), rows_(rows.size()) {
+
+        std::vector<std::int64_t> matrix;
+        matrix.reserve(rows.size() * columns_);
+        for (const auto &row : rows) {
+            assert(row.size() == columns_);
+            matrix.insert(matrix.end(), row.begin(), row.end());
+        }
+        matrix_ = std::make_shared<const std::vector<std::int64_t>>(std::move(matrix));
+    }
+
+    size_t VariablesCount() const {
+        return columns_;
+    }
+
+    size_t RowsCount() const {
+        return rows_;
+    }
+
+    std::int64_t At(size_t row, size_t column) const {
+        return (*matrix_)[row * columns_ + column];
+    }
+
+    size_t KeySize() const {
+        return rows_;
+    }
+
+    std::int64_t KeyEntry(size_t row, const Monom &monom) const {
+        assert(monom.FirstIndexAfterLastNonZeroDegree() <= columns_);
+
+        const std::int64_t *entries = matrix_->data() + row * columns_;
+        std::int64_t entry = 0;
+        for (auto it = monom.begin(); it != monom.end(); ++it) {
+            entry += entries[it - monom.begin()] * static_cast<std::int64_t>(*it);
+        }
+        return entry;
+    }
+
+    // Appends the KeySize() entries of the key of monom
+    void AppendKey(const Monom &monom, std::vector<std::int64_t> &keys) const {
+        assert(columns_ != 0 && monom.FirstIndexAfterLastNonZeroDegree() <= columns_);
+
+        size_t first = keys.size();
+        keys.resize(first + rows_, 0);
+        for (auto it = monom.begin(); it != monom.end(); ++it) {
+            if (*it == 0) {
+                continue;
+            }
+            size_t column = it - monom.begin();
+            for (size_t row = 0; row < rows_; ++row) {
+                keys[first + row] += At(row, column) * static_cast<std::int64_t>(*it);
+            }
+        }
+    }
+
+    bool operator()(const Monom &a, const Monom &b) const {
+        assert(columns_ != 0);
+
+        for (size_t row = 0; row < rows_; ++row) {
+            std::int64_t first = KeyEntry(row, a), second = KeyEntry(row, b);
+            if (first != second) {
+                return first > second;
+            }
+        }
+        return false;
+    }
+
+    bool operator==(const MatrixOrder &other) const {
+        if (columns_ != other.columns_ || !matrix_ != !other.matrix_) {
+            return false;
+        }
+        return matrix_ == other.matrix_ || *matrix_ == *other.matrix_;
+    }
+
+    template <typename Stream>
+    friend Stream &operator<<(Stream &stream, const MatrixOrder &order) {
+        stream << order.RowsCount() << "x" << order.VariablesCount();
+        for (size_t row = 0; row < order.RowsCount(); ++row) {
+            for (size_t column = 0; column < order.VariablesCount(); ++column) {
+                stream << " " << order.At(row, column);
+            }
+        }
+        return stream;
+    }
+
+protected:
+    // GrevLex on the variables [begin, end) of n: total degree, then the reversed variables
+    static void AppendGrevLexRows(std::vector<std::vector<std::int64_t>> &rows, size_t n,
+                                  size_t begin, size_t end) {
+        if (begin == end) {
+            return;
+        }
+
+        std::vector<std::int64_t> degree(n, 0);
+        std::fill(degree.begin() + begin, degree.begin() + end, 1);
+        rows.push_back(std::move(degree));
+
+        for (size_t column = end - 1; column > begin; --column) {
+            std::vector<std::int64_t> row(n, 0);
+            row[column] = -1;
+            rows.push_back(std::move(row));
+        }
+    }
+
+private:
+    size_t columns_ = 0;
+    size_t rows_ = 0;
+    std::shared_ptr<const std::vector<std::int64_t>> matrix_;
+};
+
+// Weighted degree, ties are broken by GrevLex
+class WeightedOrder : public MatrixOrder {
+public:
+    static constexpr const char *kName = "weighted";
+
+    WeightedOrder() = default;
+
+    explicit WeightedOrder(const std::vector<std::int64_t> &weights)
+        : MatrixOrder(BuildRows(weights)) {
+    }
+
+private:
+    static std::vector<std::vector<std::int64_t>> BuildRows(
+        const std::vector<std::int64_t> &weights) {
+
+        assert(std::all_of(weights.begin(), weights.end(), [](auto w) { return w >= 0; }));
+
+        std::vector<std::vector<std::int64_t>> rows = {weights};
+        AppendGrevLexRows(rows, weights.size(), 0, weights.size());
+        return rows;
+    }
+};
+
+// Block (elimination) order: blocks of consecutive variables compared one after another,
+// GrevLex inside a block. Any monomial with a variable of the first block is larger than
+// every monomial without them.
+class BlockOrder : public MatrixOrder {
+public:
+    static constexpr const char *kName = "block";
+
+    BlockOrder() = default;
+
+    explicit BlockOrder(const std::vector<size_t> &block_sizes)
+        : MatrixOrder(BuildRows(block_sizes)) {
+    }
+
+private:
+    static std::vector<std::vector<std::int64_t>> BuildRows(
+        const std::vector<size_t> &block_sizes) {
+
+        size_t n = std::accumulate(block_sizes.begin(), block_sizes.end(), size_t(0));
+
+        std::vector<std::vector<std::int64_t>> rows;
+        size_t begin = 0;
+        for (auto size : block_sizes) {
+            AppendGrevLexRows(rows, n, begin, begin + size);
+            begin += size;
+        }
+        return rows;
+    }
+};
+
+// Elimination order for the given variables among n: the total degree in the eliminated
+// variables first, then GrevLex on all of them. Cheaper than Lex and any monomial with an
+// eliminated variable is still larger than every monomial without them.
+class EliminationOrder : public MatrixOrder {
+public:
+    static constexpr const char *kName = "elimination";
+
+    EliminationOrder() = default;
+
+    EliminationOrder(size_t n, const std::vector<size_t> &eliminated)
+        : MatrixOrder(BuildRows(n, eliminated)) {
+    }
+
+private:
+    static std::vector<std::vector<std::int64_t>> BuildRows(size_t n,
+                                                            const std::vector<size_t> &eliminated) {
+
+        std::vector<std::vector<std::int64_t>> rows = {std::vector<std::int64_t>(n, 0)};
+        for (auto variable : eliminated) {
+            assert(variable < n);
+            rows.front()[variable] = 1;
+        }
+        AppendGrevLexRows(rows, n, 0, n);
+        return rows;
+    }
+};
+
+// Orders comparing monomials by keys of KeySize() integers, see MatrixOrder
+template <typename Order>
+concept HasOrderKey = requires(const Order &order, const Monom &monom,
+                               std::vector<std::int64_t> &keys) {
+    { order.KeySize() } -> std::convertible_to<size_t>;
+    order.AppendKey(monom, keys);
+};
+
+// Orders which compare the total degrees first
+template <typename Order>
+concept DegreeOrder = std::same_as<Order, GrLexOrder> || std::same_as<Order, GrevLexOrder>;
+
+template <typename Order>
+bool IsSameOrder(const Order &first, const Order &second) {
+    if constexpr (std::equality_comparable<Order>) {
+        return first == second;
+    } else {
+        return true;
+    }
+}
+
 }  // namespace groebner_basis
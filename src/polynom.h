@@ -1,13 +1,28 @@
+#pragma once
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <optional>
+#include <queue>
+#include <type_traits>
+#include <vector>
 #include "term.h"
 #include <sstream>
 
 namespace groebner_basis {
 
+template <typename Field>
+concept HashableField = requires(const Field& c) {
+    { std::hash<Field>()(c) } -> std::convertible_to<size_t>;
+};
+
 template <typename Field, typename Order = GrevLexOrder>
 class Polynom {
 public:
@@ -15,6 +30,9 @@ public:
 
     class Builder {
     public:
+        explicit Builder(const Order& order = Order()) : order_(order) {
+        }
+
         Builder& AddTerm(const Field& coef, std::initializer_list<Monom::Degree> degrees_list) {
 
             raw_data_.emplace_back(coef, degrees_list);
@@ -34,11 +52,12 @@ public:
         }
 
         Polynom BuildPolynom() {
-            return Polynom(OrderAndReduceVector(std::move(raw_data_)));
+            return FromUnorderedTerms(std::move(raw_data_), order_);
         }
 
     private:
         std::vector<Term> raw_data_;
+        [[no_unique_address]] Order order_;
     };
     friend class Builder;
 
@@ -48,46 +67,168 @@ public:
         assert(IsCorrect());
     }
 
-    Polynom(const Term& term) : Polynom(ReduceSimilar({term})) {
+    Polynom(const Term& term, const Order& order = Order())
+        : Polynom(ReduceSimilar({term}), order) {
         assert(IsCorrect());
     }
 
-    static Polynom BuildFromString(const std::string& str) {
-        return ParseAndBuild(str);
+    static Polynom BuildFromString(const std::string& str, const Order& order = Order()) {
+        return ParseAndBuild(str, order);
+    }
+
+    // terms must be already sorted by Order, without similar terms and zero coefficients
+    static Polynom BuildFromOrderedTerms(std::vector<Term>&& terms,
+                                         const Order& order = Order()) {
+        return Polynom(std::move(terms), order);
+    }
+
+    const Order& GetOrder() const {
+        return order_;
     }
 
     const Term& GetLargestTerm() const {
-        return data_->front();
+        return data_->terms.front();
     }
 
     auto begin() const {  // NOLINT
-        return data_->begin();
+        return data_->terms.cbegin();
     }
 
     auto end() const {  // NOLINT
-        return data_->end();
+        return data_->terms.cend();
     }
 
     size_t TermsCount() const {
-        return data_->size();
+        return data_->terms.size();
     }
 
     bool IsZero() const {
-        return data_->empty();
+        return data_->terms.empty();
+    }
+
+    // Computed once and shared by the copies. Coefficients take part if std::hash supports
+    // Field, otherwise polynomials with the same monomials collide and NormalFormCache
+    // cannot be used.
+    size_t Hash() const {
+        size_t hash = data_->hash.load(std::memory_order_relaxed);
+        if (hash == 0) {
+            hash = ComputeHash();
+            data_->hash.store(hash, std::memory_order_relaxed);
+        }
+        return hash;
+    }
+
+    // Term by term; see Evaluator for many points
+    Field Evaluate(const std::vector<Field>& point) const {
+        Field result(0);
+        for (const auto& t : data_->terms) {
+            Field value = t.GetCoefficient();
+            for (auto it = t.begin(); it != t.end(); ++it) {
+                assert(static_cast<size_t>(it - t.begin()) < point.size());
+                for (Monom::Degree d = 0; d < *it; ++d) {
+                    value *= point[it - t.begin()];
+                }
+            }
+            result += value;
+        }
+        return result;
     }
 
     Polynom operator-() const {
         std::vector<Term> data;
-        data.reserve(data_->size());
+        data.reserve(data_->terms.size());
 
         for (const auto& t : (*this)) {
             data.emplace_back(-t);
         }
 
-        return Polynom(std::move(data));
+        return Polynom(std::move(data), Keys(data_->keys), order_);
+    }
+
+    // The in-place operations below change the storage directly when this polynomial is its
+    // only owner and copy it first when it is shared with other copies.
+
+    void Scale(const Field& coef) {
+        if (coef == Field(1)) {
+            return;
+        }
+        if (coef == Field(0)) {
+            *this = Polynom(std::vector<Term>(), order_);
+            return;
+        }
+
+        for (auto& t : MutableData()) {
+            t.SetCoefficient(t.GetCoefficient() * coef);
+        }
+    }
+
+    void Negate() {
+        for (auto& t : MutableData()) {
+            t.SetCoefficient(-t.GetCoefficient());
+        }
+    }
+
+    // Divides by the leading coefficient
+    void MakeMonic() {
+        if (!IsZero()) {
+            Scale(Field(1) / GetLargestTerm().GetCoefficient());
+        }
+    }
+
+    // this -= term * g; the terms of this are moved, not copied, into the result
+    void SubtractMultiple(const Term& term, const Polynom& g) {
+
+        if (g.IsZero() || term.GetCoefficient() == Field(0)) {
+            return;
+        }
+
+        const Order& order = CommonOrder(*this, g);
+        Term negated = -term;
+
+        std::vector<Term> product;
+        product.reserve(g.TermsCount());
+        for (const auto& t : g) {
+            product.push_back(t * negated);
+        }
+        Keys product_keys = ShiftKeys(g.data_->keys, term.GetMonom(), order);
+
+        std::vector<Term> result;
+        Keys result_keys;
+        result.reserve(data_->terms.size() + product.size());
+        auto product_begin = std::make_move_iterator(product.begin());
+        auto product_end = std::make_move_iterator(product.end());
+
+        if (IsOnlyOwner()) {
+            MergeTerms(std::make_move_iterator(data_->terms.begin()),
+                       std::make_move_iterator(data_->terms.end()), data_->keys, product_begin,
+                       product_end, product_keys, order, result, result_keys);
+            data_->terms = std::move(result);
+            data_->keys = std::move(result_keys);
+            data_->hash.store(0, std::memory_order_relaxed);
+        } else {
+            // the shared terms are copied by the merge itself
+            MergeTerms(data_->terms.cbegin(), data_->terms.cend(), data_->keys, product_begin,
+                       product_end, product_keys, order, result, result_keys);
+            data_ = std::make_shared<Storage>(std::move(result), std::move(result_keys));
+        }
+        order_ = order;
     }
 
+    // Products of at least this many term pairs are merged by a heap instead of being sorted
+    static constexpr size_t kHeapProductThreshold = 1024;
+    // Multiply(first, second, pool) splits products of at least this many term pairs
+    static constexpr size_t kParallelProductThreshold = 1 << 16;
+
     friend Polynom operator*(const Polynom& first, const Polynom& second) {
+        const Order& order = CommonOrder(first, second);
+
+        if (first.TermsCount() * second.TermsCount() >= kHeapProductThreshold) {
+            const auto& [shorter, longer] = first.TermsCount() <= second.TermsCount()
+                                                ? std::tie(first, second)
+                                                : std::tie(second, first);
+            return HeapProduct(shorter, 0, shorter.TermsCount(), longer, order);
+        }
+
         std::vector<Term> result;
         result.reserve(first.TermsCount() * second.TermsCount());
 
@@ -97,16 +238,87 @@ public:
             }
         }
 
-        return Polynom(OrderAndReduceVector(std::move(result)));
+        return FromUnorderedTerms(std::move(result), order);
+    }
+
+    // The longer factor is split into chunks whose products with the shorter one are computed
+    // in parallel on pool (a ThreadPool), the chunk products are then merged pairwise
+    template <typename Pool>
+    friend Polynom Multiply(const Polynom& first, const Polynom& second, Pool& pool) {
+
+        size_t chunks = std::min(std::max(first.TermsCount(), second.TermsCount()),
+                                 4 * pool.Size());
+        if (first.TermsCount() * second.TermsCount() < kParallelProductThreshold || chunks < 2) {
+            return first * second;
+        }
+
+        const Order& order = CommonOrder(first, second);
+        const auto& [shorter, longer] = first.TermsCount() <= second.TermsCount()
+                                            ? std::tie(first, second)
+                                            : std::tie(second, first);
+
+        std::vector<Polynom> products(chunks);
+        pool.ParallelFor(chunks, [&](size_t chunk, size_t) {
+            size_t begin = longer.TermsCount() * chunk / chunks;
+            size_t end = longer.TermsCount() * (chunk + 1) / chunks;
+            products[chunk] = HeapProduct(longer, begin, end, shorter, order);
+        });
+
+        for (size_t step = 1; step < chunks; step *= 2) {
+            pool.ParallelFor((chunks + 2 * step - 1) / (2 * step), [&](size_t pair, size_t) {
+                size_t left = 2 * step * pair, right = left + step;
+                if (right >= chunks) {
+                    return;
+                }
+                Storage& first_storage = *products[left].data_;
+                Storage& second_storage = *products[right].data_;
+                std::vector<Term> merged;
+                Keys merged_keys;
+                merged.reserve(first_storage.terms.size() + second_storage.terms.size());
+                MergeTerms(std::make_move_iterator(first_storage.terms.begin()),
+                           std::make_move_iterator(first_storage.terms.end()), first_storage.keys,
+                           std::make_move_iterator(second_storage.terms.begin()),
+                           std::make_move_iterator(second_storage.terms.end()),
+                           second_storage.keys, order, merged, merged_keys);
+                products[left] = Polynom(std::move(merged), std::move(merged_keys), order);
+                products[right] = Polynom();
+            });
+        }
+
+        return products.front();
+    }
+
+    // Multiplication by a monomial keeps the terms ordered, so nothing has to be sorted
+    friend Polynom operator*(const Polynom& poly, const Term& term) {
+        if (term.GetCoefficient() == Field(0)) {
+            return Polynom(std::vector<Term>(), poly.order_);
+        }
+
+        std::vector<Term> result;
+        result.reserve(poly.TermsCount());
+
+        for (const auto& t : poly) {
+            result.push_back(t * term);
+        }
+
+        return Polynom(std::move(result), ShiftKeys(poly.data_->keys, term.GetMonom(), poly.order_),
+                       poly.order_);
+    }
+
+    friend Polynom operator*(const Term& term, const Polynom& poly) {
+        return poly * term;
     }
 
     friend Polynom operator+(const Polynom& first, const Polynom& second) {
+        const Order& order = CommonOrder(first, second);
+
         std::vector<Term> result;
+        Keys keys;
         result.reserve(first.TermsCount() + second.TermsCount());
 
-        std::merge(first.begin(), first.end(), second.begin(), second.end(),
-                   std::back_inserter(result), Order());
-        return Polynom(ReduceSimilar(std::move(result)));
+        MergeTerms(first.begin(), first.end(), first.data_->keys, second.begin(), second.end(),
+                   second.data_->keys, order, result, keys);
+        return Polynom(std::move(result), std::move(keys), order);
     }
 
     friend Polynom operator-(const Polynom& first, const Polynom& second) {
@@ -114,7 +326,16 @@ public:
     }
 
     friend bool operator==(const Polynom& first, const Polynom& second) {
-        return *first.data_ == *second.data_;
+        if (first.data_ == second.data_) {
+            return true;
+        }
+        if (first.data_->hash.load(std::memory_order_relaxed) !=
+                second.data_->hash.load(std::memory_order_relaxed) &&
+            first.data_->hash.load(std::memory_order_relaxed) != 0 &&
+            second.data_->hash.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+        return first.data_->terms == second.data_->terms;
     }
 
     friend bool operator!=(const Polynom& first, const Polynom& second) {
@@ -131,7 +352,7 @@ public:
             } else if (it1->GetMonom() == it2->GetMonom()) {
                 return it1->GetCoefficient() > it2->GetCoefficient();
             } else {
-                return Order()(*it1, *it2);
+                return first.order_(*it1, *it2);
             }
         }
 
@@ -165,7 +386,9 @@ public:
         Term divisible_term = optdiv.value();
         Term t = divisible_term / g.GetLargestTerm();
 
-        return *this - t * g;
+        Polynom res = *this;
+        res.SubtractMultiple(t, g);
+        return res;
     }
 
     std::optional<Polynom> ElementaryReduceWithRepeatBy(const Polynom& g) const {
@@ -185,6 +408,11 @@ public:
     }
 
 private:
+    // For orders with keys every term carries the KeySize() entries of its key, see MatrixOrder
+    static constexpr bool kHasKeys = HasOrderKey<Order>;
+    struct NoKeys {};
+    using Keys = std::conditional_t<kHasKeys, std::vector<std::int64_t>, NoKeys>;
+
     static std::vector<Term> ReduceSimilar(std::vector<Term>&& data) {
 
         if (data.empty()) {
@@ -217,22 +445,269 @@ private:
         return std::move(data);
     }
 
-    static std::vector<Term> OrderAndReduceVector(std::vector<Term>&& data) {
+    static Keys ComputeKeys(const std::vector<Term>& terms, const Order& order) {
+        Keys keys;
+        if constexpr (kHasKeys) {
+            keys.reserve(terms.size() * order.KeySize());
+            for (const auto& t : terms) {
+                order.AppendKey(t, keys);
+            }
+        }
+        return keys;
+    }
 
-        std::sort(data.begin(), data.end(), Order());
-        return ReduceSimilar(std::move(data));
+    // Keys of the terms multiplied by monom: the key of monom is added to each of them
+    static Keys ShiftKeys(Keys keys, const Monom& monom, const Order& order) {
+        if constexpr (kHasKeys) {
+            if (keys.empty()) {
+                return keys;
+            }
+            std::vector<std::int64_t> shift;
+            order.AppendKey(monom, shift);
+            for (size_t first = 0; first < keys.size(); first += shift.size()) {
+                for (size_t row = 0; row < shift.size(); ++row) {
+                    keys[first + row] += shift[row];
+                }
+            }
+        }
+        return keys;
     }
 
-    Polynom(std::vector<Term>&& prepared_vec)
-        : data_(std::make_shared<const std::vector<Term>>(std::move(prepared_vec))) {
+    // Sign of the lexicographic comparison of two keys of size entries
+    static int CompareKeys(const std::int64_t* first, const std::int64_t* second, size_t size) {
+        for (size_t row = 0; row < size; ++row) {
+            if (first[row] != second[row]) {
+                return first[row] > second[row] ? 1 : -1;
+            }
+        }
+        return 0;
+    }
+
+    // Appends a term with its key to ordered terms. A term with the same key as the last one
+    // is added to it, a zero sum or a zero term is dropped.
+    static void PushWithKey(std::vector<Term>& terms, std::vector<std::int64_t>& keys,
+                            Term term, const std::int64_t* key, size_t size) {
+        if (!terms.empty() && CompareKeys(keys.data() + keys.size() - size, key, size) == 0) {
+            terms.back().SetCoefficient(terms.back().GetCoefficient() + term.GetCoefficient());
+        } else {
+            terms.push_back(std::move(term));
+            keys.insert(keys.end(), key, key + size);
+        }
+        if (terms.back().GetCoefficient() == Field(0)) {
+            terms.pop_back();
+            keys.resize(keys.size() - size);
+        }
+    }
+
+    static Polynom FromUnorderedTerms(std::vector<Term>&& data, const Order& order) {
+
+        if constexpr (kHasKeys) {
+            // every key is computed once, then the terms are sorted by their keys
+            size_t size = order.KeySize();
+            Keys keys = ComputeKeys(data, order);
+            std::vector<uint32_t> permutation(data.size());
+            std::iota(permutation.begin(), permutation.end(), 0);
+            std::sort(permutation.begin(), permutation.end(), [&](uint32_t a, uint32_t b) {
+                return CompareKeys(keys.data() + a * size, keys.data() + b * size, size) > 0;
+            });
+
+            std::vector<Term> terms;
+            Keys sorted_keys;
+            terms.reserve(data.size());
+            sorted_keys.reserve(keys.size());
+            for (auto index : permutation) {
+                PushWithKey(terms, sorted_keys, std::move(data[index]),
+                            keys.data() + index * size, size);
+            }
+            return Polynom(std::move(terms), std::move(sorted_keys), order);
+        } else {
+            std::sort(data.begin(), data.end(), order);
+            return Polynom(ReduceSimilar(std::move(data)), order);
+        }
+    }
+
+    // Products of the terms [first_row, last_row) of first with second, ordered and without
+    // similar terms. They are generated in decreasing order from a heap which holds at most one
+    // candidate per term of first, so nothing but the result is stored. With keys the
+    // candidates are compared by the sums of the keys of their factors.
+    static Polynom HeapProduct(const Polynom& first, size_t first_row, size_t last_row,
+                               const Polynom& second, const Order& order) {
+
+        // first[i] * second[j]
+        struct Candidate {
+            Monom monom;
+            uint32_t i;
+            uint32_t j;
+        };
+
+        const auto& rows = first.data_->terms;
+        const auto& columns = second.data_->terms;
+        size_t size = 0;
+        if constexpr (kHasKeys) {
+            size = order.KeySize();
+        }
+        auto key_entry = [&](const auto& candidate, size_t row) {
+            return first.data_->keys[candidate.i * size + row] +
+                   second.data_->keys[candidate.j * size + row];
+        };
+
+        auto less = [&](const Candidate& a, const Candidate& b) {
+            if constexpr (kHasKeys) {
+                for (size_t row = 0; row < size; ++row) {
+                    std::int64_t first_entry = key_entry(a, row), second_entry = key_entry(b, row);
+                    if (first_entry != second_entry) {
+                        return first_entry < second_entry;
+                    }
+                }
+                return false;
+            } else {
+                return order(b.monom, a.monom);
+            }
+        };
+        std::priority_queue<Candidate, std::vector<Candidate>, decltype(less)> heap(less);
+
+        auto push = [&](uint32_t i, uint32_t j) {
+            heap.push({rows[i].GetMonom() * columns[j].GetMonom(), i, j});
+        };
+
+        std::vector<Term> result;
+        Keys keys;
+        if (first_row == last_row || second.IsZero()) {
+            return Polynom(std::move(result), std::move(keys), order);
+        }
+
+        std::vector<std::int64_t> key(size);
+        push(first_row, 0);
+        while (!heap.empty()) {
+            Candidate top = heap.top();
+            heap.pop();
+
+            // the products of row i + 1 start below the first one of row i
+            if (top.j == 0 && top.i + 1 < last_row) {
+                push(top.i + 1, 0);
+            }
+            if (top.j + 1 < second.TermsCount()) {
+                push(top.i, top.j + 1);
+            }
+
+            Term product(rows[top.i].GetCoefficient() * columns[top.j].GetCoefficient(),
+                         std::move(top.monom));
+            if constexpr (kHasKeys) {
+                for (size_t row = 0; row < size; ++row) {
+                    key[row] = key_entry(top, row);
+                }
+                PushWithKey(result, keys, std::move(product), key.data(), size);
+            } else {
+                if (!result.empty() && result.back().GetMonom() == product.GetMonom()) {
+                    result.back().SetCoefficient(result.back().GetCoefficient() +
+                                                 product.GetCoefficient());
+                } else {
+                    if (!result.empty() && result.back().GetCoefficient() == Field(0)) {
+                        result.pop_back();
+                    }
+                    result.push_back(std::move(product));
+                }
+            }
+        }
+        if (!result.empty() && result.back().GetCoefficient() == Field(0)) {
+            result.pop_back();
+        }
+        return Polynom(std::move(result), std::move(keys), order);
+    }
+
+    // Merges two ordered term sequences with their keys into result, similar terms are added
+    // and zero sums dropped. Works with move iterators too, then the terms are moved into result
+    template <typename Iterator1, typename Iterator2>
+    static void MergeTerms(Iterator1 first1, Iterator1 last1, const Keys& keys1, Iterator2 first2,
+                           Iterator2 last2, const Keys& keys2, const Order& order,
+                           std::vector<Term>& result, Keys& result_keys) {
+
+        if constexpr (kHasKeys) {
+            // the keys decide, so no monomial is compared
+            size_t size = order.KeySize();
+            result_keys.reserve(keys1.size() + keys2.size());
+            const std::int64_t* key1 = keys1.data();
+            const std::int64_t* key2 = keys2.data();
+            while (first1 != last1 && first2 != last2) {
+                int comparison = CompareKeys(key1, key2, size);
+                if (comparison > 0) {
+                    PushWithKey(result, result_keys, *first1, key1, size);
+                    ++first1;
+                    key1 += size;
+                } else if (comparison < 0) {
+                    PushWithKey(result, result_keys, *first2, key2, size);
+                    ++first2;
+                    key2 += size;
+                } else {
+                    Term sum = *first1;
+                    sum.SetCoefficient(sum.GetCoefficient() + (*first2).GetCoefficient());
+                    PushWithKey(result, result_keys, std::move(sum), key1, size);
+                    ++first1, ++first2;
+                    key1 += size, key2 += size;
+                }
+            }
+            for (; first1 != last1; ++first1, key1 += size) {
+                PushWithKey(result, result_keys, *first1, key1, size);
+            }
+            for (; first2 != last2; ++first2, key2 += size) {
+                PushWithKey(result, result_keys, *first2, key2, size);
+            }
+        } else {
+            std::merge(first1, last1, first2, last2, std::back_inserter(result), order);
+            result = ReduceSimilar(std::move(result));
+        }
+    }
+
+    // use_count reads the counter relaxed. Another thread may have just dropped its copy, so
+    // the fence orders our writes after its last reads of the storage.
+    bool IsOnlyOwner() const {
+        if (data_.use_count() != 1) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    std::vector<Term>& MutableData() {
+        if (!IsOnlyOwner()) {
+            data_ = std::make_shared<Storage>(*data_);
+        }
+        data_->hash.store(0, std::memory_order_relaxed);
+        return data_->terms;
+    }
+
+    size_t ComputeHash() const {
+        size_t hash = TermsCount();
+        for (const auto& t : data_->terms) {
+            hash = HashCombine(hash, t.GetMonom().Hash());
+            if constexpr (HashableField<Field>) {
+                hash = HashCombine(hash, std::hash<Field>()(t.GetCoefficient()));
+            }
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
+    static const Order& CommonOrder(const Polynom& first, const Polynom& second) {
+        assert(first.IsZero() || second.IsZero() || IsSameOrder(first.order_, second.order_));
+        return first.IsZero() ? second.order_ : first.order_;
+    }
+
+    Polynom(std::vector<Term>&& prepared_vec, const Order& order)
+        : Polynom(std::move(prepared_vec), ComputeKeys(prepared_vec, order), order) {
+    }
+
+    Polynom(std::vector<Term>&& prepared_vec, Keys&& keys, const Order& order)
+        : data_(std::make_shared<Storage>(std::move(prepared_vec), std::move(keys))),
+          order_(order) {
         assert(IsCorrect());
     }
 
-    static Polynom ParseAndBuild(const std::string& str) {  // works only with xyz
+    // works only with xyz
+    static Polynom ParseAndBuild(const std::string& str, const Order& order) {
         std::stringstream ss;
         ss << str;
 
-        Polynom::Builder builder;
+        Polynom::Builder builder(order);
 
         Field current_coef = 1;
         std::vector<Monom::Degree> degs(3, 0);
@@ -311,7 +786,7 @@ private:
         }
 
         for (auto it = begin() + 1; it != end(); ++it) {
-            if (!Order()(*(it - 1), *it)) {
+            if (!order_(*(it - 1), *it)) {
                 return false;
             }
         }
@@ -329,10 +804,41 @@ private:
             }
         }
 
+        if constexpr (kHasKeys) {
+            if (data_->keys != ComputeKeys(data_->terms, order_)) {
+                return false;
+            }
+        }
+
         return true;
     }
 
-    std::shared_ptr<const std::vector<Term>> data_ = std::make_shared<const std::vector<Term>>();
+    // the terms, their keys and their hash, shared by the copies of a polynomial until one
+    // is changed
+    struct Storage {
+        Storage() = default;
+
+        Storage(std::vector<Term>&& prepared_terms, Keys&& prepared_keys)
+            : terms(std::move(prepared_terms)), keys(std::move(prepared_keys)) {
+        }
+
+        Storage(const Storage& other) : terms(other.terms), keys(other.keys) {
+        }
+
+        std::vector<Term> terms;
+        [[no_unique_address]] Keys keys;
+        std::atomic<size_t> hash = 0;  // 0 until computed
+    };
+
+    std::shared_ptr<Storage> data_ = std::make_shared<Storage>();
+    [[no_unique_address]] Order order_;
 };
 
 }  // namespace groebner_basis
+
+template <typename Field, typename Order>
+struct std::hash<groebner_basis::Polynom<Field, Order>> {
+    size_t operator()(const groebner_basis::Polynom<Field, Order>& poly) const {
+        return poly.Hash();
+    }
+};
@@ -0,0 +1,414 @@
+#pragma once
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+#include "polynom.h"
+#include "types.h"
+
+namespace groebner_basis {
+
+// Exact integer. Values that fit into int64_t are kept inline and added, subtracted and
+// multiplied with overflow checks, the others are kept as a shared immutable cpp_int, so the
+// common small values never allocate. Both fit into 16 bytes.
+class Integer {
+public:
+    using Big = boost::multiprecision::cpp_int;
+
+    Integer() = default;
+
+    Integer(int64_t value) : small_(value) {
+    }
+
+    explicit Integer(const Big& value) {
+        if (value >= std::numeric_limits<int64_t>::min() &&
+            value <= std::numeric_limits<int64_t>::max()) {
+            small_ = static_cast<int64_t>(value);
+        } else {
+            big_ = new BigValue(value);
+        }
+    }
+
+    bool IsSmall() const {
+        return !big_;
+    }
+
+    Big ToBig() const {
+        return big_ ? big_->value : Big(small_);
+    }
+
+    size_t Hash() const {
+        return big_ ? boost::multiprecision::hash_value(big_->value)
+                    : std::hash<int64_t>()(small_);
+    }
+
+    int Sign() const {
+        return big_ ? big_->value.sign() : (small_ > 0) - (small_ < 0);
+    }
+
+    Integer Abs() const {
+        return Sign() < 0 ? -*this : *this;
+    }
+
+    Integer operator-() const {
+        if (IsSmall() && small_ != std::numeric_limits<int64_t>::min()) {
+            return -small_;
+        }
+        return Integer(Big(-ToBig()));
+    }
+
+    friend Integer operator+(const Integer& first, const Integer& second) {
+        int64_t result;
+        if (first.IsSmall() && second.IsSmall() &&
+            !__builtin_add_overflow(first.small_, second.small_, &result)) {
+            return result;
+        }
+        return Integer(Big(first.ToBig() + second.ToBig()));
+    }
+
+    friend Integer operator-(const Integer& first, const Integer& second) {
+        int64_t result;
+        if (first.IsSmall() && second.IsSmall() &&
+            !__builtin_sub_overflow(first.small_, second.small_, &result)) {
+            return result;
+        }
+        return Integer(Big(first.ToBig() - second.ToBig()));
+    }
+
+    friend Integer operator*(const Integer& first, const Integer& second) {
+        int64_t result;
+        if (first.IsSmall() && second.IsSmall() &&
+            !__builtin_mul_overflow(first.small_, second.small_, &result)) {
+            return result;
+        }
+        return Integer(Big(first.ToBig() * second.ToBig()));
+    }
+
+    // Truncates towards zero
+    friend Integer operator/(const Integer& first, const Integer& second) {
+        assert(second.Sign() != 0);
+        if (first.IsSmall() && second.IsSmall() &&
+            !(first.small_ == std::numeric_limits<int64_t>::min() && second.small_ == -1)) {
+            return first.small_ / second.small_;
+        }
+        return Integer(Big(first.ToBig() / second.ToBig()));
+    }
+
+    friend Integer operator%(const Integer& first, const Integer& second) {
+        assert(second.Sign() != 0);
+        if (first.IsSmall() && second.IsSmall()) {
+            return second.small_ == -1 ? 0 : first.small_ % second.small_;
+        }
+        return Integer(Big(first.ToBig() % second.ToBig()));
+    }
+
+    // Nonnegative, Gcd(0, 0) = 0
+    friend Integer Gcd(const Integer& first, const Integer& second) {
+        if (first.IsSmall() && second.IsSmall()) {
+            uint64_t gcd = std::gcd(Magnitude(first.small_), Magnitude(second.small_));
+            if (gcd <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                return static_cast<int64_t>(gcd);
+            }
+        }
+        return Integer(Big(boost::multiprecision::gcd(first.ToBig(), second.ToBig())));
+    }
+
+    // Big values are out of the int64_t range, so they never equal small ones
+    friend bool operator==(const Integer& first, const Integer& second) {
+        if (first.IsSmall() != second.IsSmall()) {
+            return false;
+        }
+        return first.IsSmall() ? first.small_ == second.small_
+                               : first.big_->value == second.big_->value;
+    }
+
+    friend bool operator!=(const Integer& first, const Integer& second) {
+        return !(first == second);
+    }
+
+    friend bool operator<(const Integer& first, const Integer& second) {
+        if (first.IsSmall() && second.IsSmall()) {
+            return first.small_ < second.small_;
+        }
+        return first.ToBig() < second.ToBig();
+    }
+
+    friend bool operator>(const Integer& first, const Integer& second) {
+        return second < first;
+    }
+
+    template <typename Stream>
+    friend Stream& operator<<(Stream& stream, const Integer& value) {
+        if (value.IsSmall()) {
+            stream << value.small_;
+        } else {
+            stream << value.big_->value.str();
+        }
+        return stream;
+    }
+
+    template <typename Stream>
+    friend Stream& operator>>(Stream& stream, Integer& value) {
+        std::string digits;
+        if (stream >> digits) {
+            value = Integer(Big(digits));
+        }
+        return stream;
+    }
+
+private:
+    static uint64_t Magnitude(int64_t value) {
+        return value < 0 ? uint64_t(0) - static_cast<uint64_t>(value) : value;
+    }
+
+    struct BigValue : boost::intrusive_ref_counter<BigValue> {
+        explicit BigValue(const Big& value) : value(value) {
+        }
+
+        Big value;
+    };
+
+    int64_t small_ = 0;
+    boost::intrusive_ptr<const BigValue> big_;
+};
+
+// Exact rational number, a fraction of Integers in lowest terms with a positive denominator.
+// Sums and products of integral values need no gcd, so polynomials with integer
+// coefficients cost about as much as with int64_t ones until their coefficients overflow.
+class Rational {
+public:
+    static constexpr const char *kName = "rational";
+
+    Rational() = default;
+
+    Rational(int64_t value) : numerator_(value) {
+    }
+
+    Rational(const Integer& value) : numerator_(value) {
+    }
+
+    Rational(const Integer& numerator, const Integer& denominator) {
+        assert(denominator.Sign() != 0);
+        Integer gcd = Gcd(numerator, denominator);
+        if (denominator.Sign() < 0) {
+            gcd = -gcd;
+        }
+        numerator_ = numerator / gcd;
+        denominator_ = denominator / gcd;
+    }
+
+    const Integer& Numerator() const {
+        return numerator_;
+    }
+
+    const Integer& Denominator() const {
+        return denominator_;
+    }
+
+    bool IsInteger() const {
+        return denominator_ == 1;
+    }
+
+    Rational operator-() const {
+        return FromReduced(-numerator_, denominator_);
+    }
+
+    Rational& operator+=(const Rational& other) {
+        return *this = *this + other;
+    }
+
+    Rational& operator-=(const Rational& other) {
+        return *this = *this - other;
+    }
+
+    Rational& operator*=(const Rational& other) {
+        return *this = *this * other;
+    }
+
+    Rational& operator/=(const Rational& other) {
+        return *this = *this / other;
+    }
+
+    friend Rational operator+(const Rational& first, const Rational& second) {
+        if (first.IsInteger() && second.IsInteger()) {
+            return first.numerator_ + second.numerator_;
+        }
+        return Rational(first.numerator_ * second.denominator_ +
+                            second.numerator_ * first.denominator_,
+                        first.denominator_ * second.denominator_);
+    }
+
+    friend Rational operator-(const Rational& first, const Rational& second) {
+        return first + (-second);
+    }
+
+    // The cross gcds keep the product in lowest terms
+    friend Rational operator*(const Rational& first, const Rational& second) {
+        if (first.IsInteger() && second.IsInteger()) {
+            return first.numerator_ * second.numerator_;
+        }
+        Integer gcd1 = Gcd(first.numerator_, second.denominator_);
+        Integer gcd2 = Gcd(second.numerator_, first.denominator_);
+        if (gcd1.Sign() == 0 || gcd2.Sign() == 0) {
+            return Rational();
+        }
+        return FromReduced((first.numerator_ / gcd1) * (second.numerator_ / gcd2),
+                           (first.denominator_ / gcd2) * (second.denominator_ / gcd1));
+    }
+
+    friend Rational operator/(const Rational& first, const Rational& second) {
+        return first * second.Inverse();
+    }
+
+    friend bool operator==(const Rational& first, const Rational& second) {
+        return first.numerator_ == second.numerator_ && first.denominator_ == second.denominator_;
+    }
+
+    friend bool operator!=(const Rational& first, const Rational& second) {
+        return !(first == second);
+    }
+
+    friend bool operator<(const Rational& first, const Rational& second) {
+        if (first.IsInteger() && second.IsInteger()) {
+            return first.numerator_ < second.numerator_;
+        }
+        return first.numerator_ * second.denominator_ < second.numerator_ * first.denominator_;
+    }
+
+    friend bool operator>(const Rational& first, const Rational& second) {
+        return second < first;
+    }
+
+    template <typename Stream>
+    friend Stream& operator<<(Stream& stream, const Rational& value) {
+        stream << value.numerator_;
+        if (!value.IsInteger()) {
+            stream << "/" << value.denominator_;
+        }
+        return stream;
+    }
+
+    // n or n/d
+    template <typename Stream>
+    friend Stream& operator>>(Stream& stream, Rational& value) {
+        std::string text;
+        if (stream >> text) {
+            auto slash = text.find('/');
+            Integer::Big numerator(text.substr(0, slash));
+            Integer::Big denominator(slash == std::string::npos ? "1" : text.substr(slash + 1));
+            value = Rational(Integer(numerator), Integer(denominator));
+        }
+        return stream;
+    }
+
+private:
+    static Rational FromReduced(Integer numerator, Integer denominator) {
+        Rational result;
+        result.numerator_ = std::move(numerator);
+        result.denominator_ = std::move(denominator);
+        return result;
+    }
+
+    Rational Inverse() const {
+        assert(numerator_.Sign() != 0);
+        return numerator_.Sign() > 0 ? FromReduced(denominator_, numerator_)
+                                     : FromReduced(-denominator_, -numerator_);
+    }
+
+    Integer numerator_;
+    Integer denominator_ = 1;
+};
+
+template <>
+struct TypeName<boost::multiprecision::cpp_rational> {
+    static std::string Get() {
+        return "cpp_rational";
+    }
+};
+
+template <std::integral T>
+struct TypeName<boost::rational<T>> {
+    static std::string Get() {
+        return "boost_rational " + std::to_string(sizeof(T) * 8);
+    }
+};
+
+// Fields of fractions of Integers. PolynomialsSet keeps the elements of such fields primitive
+// while it builds a basis and reduces S-polynomials without division, see PseudoSubtract.
+template <typename Field>
+concept IntegerFractions = requires(const Field& c) {
+    { c.Numerator() } -> std::convertible_to<Integer>;
+    { c.Denominator() } -> std::convertible_to<Integer>;
+};
+
+// Scales f to integer coefficients without a common factor and a positive leading one
+template <typename Order>
+void MakePrimitive(Polynom<Rational, Order>& f) {
+
+    if (f.IsZero()) {
+        return;
+    }
+    Integer denominators = 1, numerators = 0;
+    for (const auto& t : f) {
+        const Integer& denominator = t.GetCoefficient().Denominator();
+        if (denominator != 1) {
+            denominators = denominators / Gcd(denominators, denominator) * denominator;
+        }
+        if (numerators != 1) {
+            numerators = Gcd(numerators, t.GetCoefficient().Numerator());
+        }
+    }
+    if (f.GetLargestTerm().GetCoefficient() < 0) {
+        numerators = -numerators;
+    }
+    f.Scale(Rational(denominators, numerators));
+}
+
+// f = a * f - b * m * g with the monomial m and the coprime integers a, b that cancel the
+// leading term of f. For f and g with integer coefficients there is no division and the
+// result has integer coefficients too.
+template <typename Order>
+void PseudoSubtract(Polynom<Rational, Order>& f, const Polynom<Rational, Order>& g) {
+
+    const auto& leading = f.GetLargestTerm();
+    const Integer& first = leading.GetCoefficient().Numerator();
+    const Integer& second = g.GetLargestTerm().GetCoefficient().Numerator();
+    assert(leading.GetCoefficient().IsInteger() && g.GetLargestTerm().GetCoefficient().IsInteger());
+
+    Integer gcd = Gcd(first, second);
+    Term<Rational> multiple(first / gcd, leading.GetMonom() / g.GetLargestTerm().GetMonom());
+    f.Scale(second / gcd);
+    f.SubtractMultiple(multiple, g);
+}
+
+}  // namespace groebner_basis
+
+template <>
+struct std::hash<groebner_basis::Integer> {
+    size_t operator()(const groebner_basis::Integer& value) const {
+        return value.Hash();
+    }
+};
+
+template <std::integral T>
+struct std::hash<boost::rational<T>> {
+    size_t operator()(const boost::rational<T>& value) const {
+        return groebner_basis::HashCombine(std::hash<T>()(value.numerator()),
+                                           std::hash<T>()(value.denominator()));
+    }
+};
+
+template <>
+struct std::hash<groebner_basis::Rational> {
+    size_t operator()(const groebner_basis::Rational& value) const {
+        return groebner_basis::HashCombine(value.Numerator().Hash(), value.Denominator().Hash());
+    }
+};
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "polynom.h"
+#include "thread_pool.h"
+
+namespace groebner_basis {
+
+// Normal form engine compiled once from a fixed basis (normally the reduced Groebner basis).
+// Leading monomials are indexed by divisibility masks, reducer multiples are cached per worker
+// and the reduction itself runs on a heap of term streams, so no intermediate Polynom is built.
+template <typename Field, typename Order = GrevLexOrder>
+class Reducer {
+public:
+    using PolynomType = Polynom<Field, Order>;
+    using TermType = Term<Field>;
+
+    // Scratch memory of the reductions on one thread. It may be reused with other reducers:
+    // the cached multiples belong to one reducer and are dropped when another one uses it,
+    // the buffers are kept.
+    class Workspace {
+    public:
+        static constexpr size_t kMaxCachedTerms = 1 << 20;
+
+    private:
+        friend class Reducer;
+
+        struct Stream {
+            const TermType* current;
+            const TermType* end;
+            Field scale;
+        };
+
+        std::vector<Stream> heap_;
+        std::vector<std::map<Monom, std::vector<TermType>, Order>> multiples_;
+        size_t cached_terms_ = 0;
+        uint64_t reducer_ = 0;  // id of the reducer the multiples belong to
+    };
+
+    // basis is a PolynomialsSet or any other range of polynomials with GetOrder()
+    template <typename Polynoms>
+    explicit Reducer(const Polynoms& basis) : id_(NextId()), order_(basis.GetOrder()) {
+
+        for (const auto& g : basis) {
+            if (g.IsZero()) {
+                continue;
+            }
+
+            Field inverse = Field(1) / g.GetLargestTerm().GetCoefficient();
+
+            Reductor reductor;
+            reductor.leading = g.GetLargestTerm().GetMonom();
+            reductor.mask = reductor.leading.DivisibilityMask();
+            reductor.degree = reductor.leading.TotalDegree();
+            reductor.tail.reserve(g.TermsCount() - 1);
+            for (auto it = g.begin() + 1; it != g.end(); ++it) {
+                reductor.tail.emplace_back(it->GetCoefficient() * inverse, it->GetMonom());
+            }
+
+            reductors_.push_back(std::move(reductor));
+        }
+
+        // low degree reductors first: they are the most likely divisors and give short multiples
+        std::stable_sort(reductors_.begin(), reductors_.end(),
+                         [](const Reductor& a, const Reductor& b) { return a.degree < b.degree; });
+    }
+
+    size_t Size() const {
+        return reductors_.size();
+    }
+
+    PolynomType NormalForm(const PolynomType& f) const {
+        Workspace workspace;
+        return NormalForm(f, workspace);
+    }
+
+    PolynomType NormalForm(const PolynomType& f, Workspace& workspace) const {
+
+        std::vector<TermType> remainder;
+        Run(f, workspace, [&](const TermType& term) {
+            remainder.push_back(term);
+            return true;
+        });
+
+        return PolynomType::BuildFromOrderedTerms(std::move(remainder), order_);
+    }
+
+    // Stops at the first irreducible leading term, which is nonzero in the normal form.
+    bool IsMember(const PolynomType& f) const {
+        Workspace workspace;
+        return IsMember(f, workspace);
+    }
+
+    bool IsMember(const PolynomType& f, Workspace& workspace) const {
+        return Run(f, workspace, [](const TermType&) { return false; });
+    }
+
+    // Keeps the leading term of f and replaces the rest with its normal form
+    PolynomType ReduceTail(const PolynomType& f, Workspace& workspace) const {
+
+        if (f.IsZero()) {
+            return f;
+        }
+
+        std::vector<TermType> result = {f.GetLargestTerm()};
+        Run(f, workspace, 1, [&](const TermType& term) {
+            result.push_back(term);
+            return true;
+        });
+
+        return PolynomType::BuildFromOrderedTerms(std::move(result), order_);
+    }
+
+    std::vector<PolynomType> NormalForms(const std::vector<PolynomType>& batch,
+                                         ThreadPool& pool) const {
+
+        std::vector<PolynomType> result(batch.size());
+        std::vector<Workspace> workspaces(pool.Size());
+
+        pool.ParallelFor(batch.size(), [&](size_t index, size_t worker) {
+            result[index] = NormalForm(batch[index], workspaces[worker]);
+        });
+
+        return result;
+    }
+
+    std::vector<bool> AreMembers(const std::vector<PolynomType>& batch, ThreadPool& pool) const {
+
+        std::vector<char> members(batch.size());
+        std::vector<Workspace> workspaces(pool.Size());
+
+        pool.ParallelFor(batch.size(), [&](size_t index, size_t worker) {
+            members[index] = IsMember(batch[index], workspaces[worker]);
+        });
+
+        return std::vector<bool>(members.begin(), members.end());
+    }
+
+private:
+    struct Reductor {
+        Monom leading;
+        uint64_t mask = 0;
+        Monom::Degree degree = 0;
+        std::vector<TermType> tail;  // already divided by the leading coefficient
+    };
+
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> last = 0;
+        return last.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    const Reductor* FindReductor(const Monom& monom) const {
+
+        uint64_t mask = monom.DivisibilityMask();
+        for (const auto& reductor : reductors_) {
+            if ((reductor.mask & ~mask) == 0 && monom.IsDivisibleBy(reductor.leading)) {
+                return &reductor;
+            }
+        }
+        return nullptr;
+    }
+
+    const std::vector<TermType>& Multiple(const Reductor& reductor, const Monom& quotient,
+                                          Workspace& workspace) const {
+
+        if (quotient.FirstIndexAfterLastNonZeroDegree() == 0) {
+            return reductor.tail;
+        }
+
+        if (workspace.reducer_ != id_) {
+            workspace.multiples_.assign(reductors_.size(),
+                                        std::map<Monom, std::vector<TermType>, Order>(order_));
+            workspace.cached_terms_ = 0;
+            workspace.reducer_ = id_;
+        }
+        auto& cache = workspace.multiples_[&reductor - reductors_.data()];
+
+        auto it = cache.find(quotient);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        std::vector<TermType> multiple;
+        multiple.reserve(reductor.tail.size());
+        for (const auto& term : reductor.tail) {
+            multiple.emplace_back(term.GetCoefficient(), term.GetMonom() * quotient);
+        }
+
+        workspace.cached_terms_ += multiple.size();
+        return cache.emplace(quotient, std::move(multiple)).first->second;
+    }
+
+    // Feeds the terms of the normal form of f to on_irreducible in decreasing order
+    // until it returns false. Returns true if the normal form was exhausted.
+    template <typename Callback>
+    bool Run(const PolynomType& f, Workspace& workspace, Callback&& on_irreducible) const {
+        return Run(f, workspace, 0, std::forward<Callback>(on_irreducible));
+    }
+
+    // the first skip terms of f are left out
+    template <typename Callback>
+    bool Run(const PolynomType& f, Workspace& workspace, size_t skip,
+             Callback&& on_irreducible) const {
+
+        using Stream = typename Workspace::Stream;
+
+        if (workspace.cached_terms_ > Workspace::kMaxCachedTerms) {
+            workspace.multiples_.clear();
+            workspace.cached_terms_ = 0;
+        }
+
+        auto& heap = workspace.heap_;
+        heap.clear();
+
+        auto less = [this](const Stream& a, const Stream& b) {
+            return order_(b.current->GetMonom(), a.current->GetMonom());
+        };
+
+        auto push = [&](const TermType* begin, const TermType* end, const Field& scale) {
+            if (begin != end) {
+                heap.push_back(Stream{begin, end, scale});
+                std::push_heap(heap.begin(), heap.end(), less);
+            }
+        };
+
+        if (f.TermsCount() > skip) {
+            push(&*f.begin() + skip, &*f.begin() + f.TermsCount(), Field(1));
+        }
+
+        while (!heap.empty()) {
+            Monom monom = heap.front().current->GetMonom();
+            Field coefficient(0);
+
+            while (!heap.empty() && heap.front().current->GetMonom() == monom) {
+                std::pop_heap(heap.begin(), heap.end(), less);
+                Stream& stream = heap.back();
+                coefficient += stream.scale * stream.current->GetCoefficient();
+
+                if (++stream.current == stream.end) {
+                    heap.pop_back();
+                } else {
+                    std::push_heap(heap.begin(), heap.end(), less);
+                }
+            }
+
+            if (coefficient == Field(0)) {
+                continue;
+            }
+
+            const Reductor* reductor = FindReductor(monom);
+            if (!reductor) {
+                if (!on_irreducible(TermType(coefficient, monom))) {
+                    return false;
+                }
+                continue;
+            }
+
+            const auto& multiple = Multiple(*reductor, monom / reductor->leading, workspace);
+            push(multiple.data(), multiple.data() + multiple.size(), -coefficient);
+        }
+
+        return true;
+    }
+
+    uint64_t id_;
+    std::vector<Reductor> reductors_;
+    [[no_unique_address]] Order order_;
+};
+
+}  // namespace groebner_basis
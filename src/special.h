@@ -0,0 +1,391 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "context.h"
+#include "functions.h"
+
+namespace groebner_basis {
+
+// Shapes of generators with a cheaper algorithm than Buchberger's, see ReducedBasisOfShape
+enum class IdealShape { kGeneral, kLinear, kUnivariate, kBinomial };
+
+// Univariate generators of larger degrees are treated as general, their dense remainders
+// would not pay off
+inline constexpr Monom::Degree kMaxUnivariateDegree = 1 << 16;
+
+template <typename Field, typename Order>
+IdealShape DetectShape(const std::vector<Polynom<Field, Order>>& generators) {
+
+    bool linear = true, binomial = true, univariate = true;
+    std::optional<size_t> variable;
+    for (const auto& f : generators) {
+        binomial = binomial && f.TermsCount() <= 2;
+        for (const auto& t : f) {
+            Monom::Degree degree = t.TotalDegree();
+            linear = linear && degree <= 1;
+            if (degree == 0 || !univariate) {
+                continue;
+            }
+            // the only variable of t is the last one with a nonzero degree
+            size_t last = t.FirstIndexAfterLastNonZeroDegree() - 1;
+            univariate = t.Deg(last) == degree && degree <= kMaxUnivariateDegree &&
+                         variable.value_or(last) == last;
+            variable = last;
+        }
+    }
+
+    if (linear) {
+        return IdealShape::kLinear;
+    }
+    if (univariate) {
+        return IdealShape::kUnivariate;
+    }
+    return binomial ? IdealShape::kBinomial : IdealShape::kGeneral;
+}
+
+// Polynomials of degree at most one: the rows of the reduced row echelon form of their
+// coefficient matrix. The columns are the monomials from the largest, so the pivots are the
+// leading terms. std::nullopt if the context stops the computation.
+template <typename Field, typename Order>
+std::optional<std::vector<Polynom<Field, Order>>> LinearReducedBasis(
+    const std::vector<Polynom<Field, Order>>& generators, const Order& order,
+    ComputationContext& context) {
+
+    std::vector<Monom> columns;
+    for (const auto& f : generators) {
+        for (const auto& t : f) {
+            columns.push_back(t.GetMonom());
+        }
+    }
+    std::sort(columns.begin(), columns.end(), order);
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+    size_t width = columns.size(), height = generators.size();
+    std::vector<Field> matrix(width * height, Field(0));
+    for (size_t row = 0; row < height; ++row) {
+        for (const auto& t : generators[row]) {
+            auto column = std::lower_bound(columns.begin(), columns.end(), t.GetMonom(), order);
+            matrix[row * width + (column - columns.begin())] = t.GetCoefficient();
+        }
+    }
+    auto entry = [&](size_t row, size_t column) -> Field& {
+        return matrix[row * width + column];
+    };
+
+    size_t rank = 0, last_pivot = 0;
+    for (size_t column = 0; column < width && rank < height; ++column) {
+        if (context.ShouldStop()) {
+            return std::nullopt;
+        }
+
+        size_t pivot = rank;
+        while (pivot < height && entry(pivot, column) == Field(0)) {
+            ++pivot;
+        }
+        if (pivot == height) {
+            continue;
+        }
+        // the rows from rank on are zero before column
+        std::swap_ranges(&entry(pivot, column), &entry(pivot, 0) + width, &entry(rank, column));
+
+        Field inverse = Field(1) / entry(rank, column);
+        for (size_t k = column; k < width; ++k) {
+            entry(rank, k) = entry(rank, k) * inverse;
+        }
+        for (size_t row = 0; row < height; ++row) {
+            Field c = entry(row, column);
+            if (row == rank || c == Field(0)) {
+                continue;
+            }
+            for (size_t k = column; k < width; ++k) {
+                entry(row, k) = entry(row, k) - c * entry(rank, k);
+            }
+        }
+        last_pivot = column;
+        ++rank;
+    }
+
+    // a pivot in the constant column, the last one, makes the ideal the whole ring
+    size_t first = rank && last_pivot + 1 == width && columns.back().TotalDegree() == 0
+                       ? rank - 1
+                       : 0;
+    std::vector<Polynom<Field, Order>> basis;
+    basis.reserve(rank - first);
+    for (size_t row = first; row < rank; ++row) {
+        std::vector<Term<Field>> terms;
+        for (size_t column = 0; column < width; ++column) {
+            if (!(entry(row, column) == Field(0))) {
+                terms.emplace_back(entry(row, column), columns[column]);
+            }
+        }
+        basis.push_back(Polynom<Field, Order>::BuildFromOrderedTerms(std::move(terms), order));
+    }
+    return basis;
+}
+
+// Polynomials in one variable: their monic greatest common divisor by Euclid's algorithm on
+// dense coefficients, an empty basis if all of them are zero. std::nullopt if the context
+// stops the computation.
+template <typename Field, typename Order>
+std::optional<std::vector<Polynom<Field, Order>>> UnivariateReducedBasis(
+    const std::vector<Polynom<Field, Order>>& generators, const Order& order,
+    ComputationContext& context) {
+
+    size_t variable = 0;
+    for (const auto& f : generators) {
+        for (const auto& t : f) {
+            variable = std::max(variable, t.FirstIndexAfterLastNonZeroDegree());
+        }
+    }
+    variable = variable ? variable - 1 : 0;
+
+    // coefficients by degree, without trailing zeros
+    auto trim = [](std::vector<Field>& a) {
+        while (!a.empty() && a.back() == Field(0)) {
+            a.pop_back();
+        }
+    };
+    auto remainder = [&](std::vector<Field>& a, const std::vector<Field>& b) {
+        while (a.size() >= b.size()) {
+            Field c = a.back() / b.back();
+            size_t shift = a.size() - b.size();
+            for (size_t k = 0; k + 1 < b.size(); ++k) {
+                a[shift + k] = a[shift + k] - c * b[k];
+            }
+            a.pop_back();
+            trim(a);
+        }
+    };
+
+    std::vector<Field> gcd, next;
+    for (const auto& f : generators) {
+        next.assign(f.IsZero() ? 0 : f.GetLargestTerm().TotalDegree() + 1, Field(0));
+        for (const auto& t : f) {
+            next[t.TotalDegree()] = t.GetCoefficient();
+        }
+        while (!next.empty()) {
+            if (context.ShouldStop()) {
+                return std::nullopt;
+            }
+            remainder(gcd, next);
+            std::swap(gcd, next);
+        }
+    }
+
+    std::vector<Polynom<Field, Order>> basis;
+    if (gcd.empty()) {
+        return basis;
+    }
+    Field inverse = Field(1) / gcd.back();
+    std::vector<Term<Field>> terms;
+    std::vector<Monom::Degree> degrees(variable + 1, 0);
+    for (size_t degree = gcd.size(); degree-- > 0;) {
+        if (!(gcd[degree] == Field(0))) {
+            degrees[variable] = static_cast<Monom::Degree>(degree);
+            terms.emplace_back(gcd[degree] * inverse, Monom::BuildFromVectorDegrees(degrees));
+        }
+    }
+    basis.push_back(Polynom<Field, Order>::BuildFromOrderedTerms(std::move(terms), order));
+    return basis;
+}
+
+// Polynomials of at most two terms. Both S-polynomials and reduction steps of such
+// polynomials have at most two terms again, so Buchberger's algorithm runs on pairs of terms
+// without building or merging polynomials.
+template <typename Field, typename Order>
+class BinomialBasisBuilder {
+public:
+    using PolynomType = Polynom<Field, Order>;
+
+    explicit BinomialBasisBuilder(const Order& order) : order_(order) {
+    }
+
+    // std::nullopt if the context stops the computation
+    std::optional<std::vector<PolynomType>> Build(const std::vector<PolynomType>& generators,
+                                                  ComputationContext& context) {
+
+        elements_.clear();
+        for (const auto& f : generators) {
+            if (!f.IsZero()) {
+                auto it = f.begin();
+                Append(Make(*it, f.TermsCount() == 2 ? *std::next(it) : Zero()));
+            }
+        }
+
+        for (size_t i = 0; i < elements_.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (context.ShouldStop()) {
+                    return std::nullopt;
+                }
+                const Monom& first = elements_[i].f.lead;
+                const Monom& second = elements_[j].f.lead;
+                if (LCM(first, second).TotalDegree() ==
+                    first.TotalDegree() + second.TotalDegree()) {
+                    continue;
+                }
+                Binomial remainder = Reduce(SPolynom(elements_[i].f, elements_[j].f), elements_);
+                if (remainder.size) {
+                    Append(remainder);
+                }
+            }
+        }
+        return ReducedBasis();
+    }
+
+private:
+    // lead is larger than tail, unused terms have zero coefficients
+    struct Binomial {
+        Term<Field> lead = Zero();
+        Term<Field> tail = Zero();
+        uint8_t size = 0;
+    };
+
+    struct Element {
+        Binomial f;
+        uint64_t mask;  // of the leading monomial
+    };
+
+    static Term<Field> Zero() {
+        return Term<Field>(Field(0));
+    }
+
+    static bool IsZero(const Term<Field>& t) {
+        return t.GetCoefficient() == Field(0);
+    }
+
+    Binomial Make(Term<Field> first, Term<Field> second) const {
+
+        if (!IsZero(first) && !IsZero(second) && first.GetMonom() == second.GetMonom()) {
+            first.SetCoefficient(first.GetCoefficient() + second.GetCoefficient());
+            second = Zero();
+        }
+        if (IsZero(first)) {
+            std::swap(first, second);
+        }
+        if (IsZero(first)) {
+            return {};
+        }
+        if (IsZero(second)) {
+            return {std::move(first), Zero(), 1};
+        }
+        if (order_(second, first)) {
+            std::swap(first, second);
+        }
+        return {std::move(first), std::move(second), 2};
+    }
+
+    void Append(Binomial f) {
+        Field inverse = Field(1) / f.lead.GetCoefficient();
+        f.lead.SetCoefficient(Field(1));
+        f.tail.SetCoefficient(f.tail.GetCoefficient() * inverse);
+        uint64_t mask = f.lead.DivisibilityMask();
+        elements_.push_back({std::move(f), mask});
+    }
+
+    Binomial SPolynom(const Binomial& f, const Binomial& g) const {
+        auto lcm = LCM(f.lead, g.lead);
+        Term<Field> t1(g.lead.GetCoefficient(), lcm / f.lead.GetMonom());
+        Term<Field> t2(f.lead.GetCoefficient(), lcm / g.lead.GetMonom());
+        return Make(f.tail * t1, -(g.tail * t2));
+    }
+
+    static const Element* FindDivisor(const Monom& m, const std::vector<Element>& elements) {
+        uint64_t mask = m.DivisibilityMask();
+        for (const auto& element : elements) {
+            if ((element.mask & ~mask) == 0 && m.IsDivisibleBy(element.f.lead)) {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+
+    // t - (t / lead) * g, the leads of the elements are monic
+    static Term<Field> ReductionStep(const Term<Field>& t, const Binomial& g) {
+        return -(g.tail * Term<Field>(t.GetCoefficient(), t.GetMonom() / g.lead.GetMonom()));
+    }
+
+    // Full reduction, every step replaces a term by a smaller one
+    Binomial Reduce(Binomial f, const std::vector<Element>& elements) const {
+        while (f.size) {
+            auto divisor = FindDivisor(f.lead, elements);
+            if (!divisor) {
+                break;
+            }
+            f = Make(ReductionStep(f.lead, divisor->f), f.tail);
+        }
+        return ReduceTail(std::move(f), elements);
+    }
+
+    Binomial ReduceTail(Binomial f, const std::vector<Element>& elements) const {
+        while (f.size == 2) {
+            auto divisor = FindDivisor(f.tail, elements);
+            if (!divisor) {
+                break;
+            }
+            f = Make(f.lead, ReductionStep(f.tail, divisor->f));
+        }
+        return f;
+    }
+
+    // Minimize and reduce the tails as PolynomialsSet::InterReduce does
+    std::vector<PolynomType> ReducedBasis() const {
+
+        std::vector<size_t> by_degree(elements_.size());
+        std::iota(by_degree.begin(), by_degree.end(), 0);
+        std::stable_sort(by_degree.begin(), by_degree.end(), [this](size_t a, size_t b) {
+            return elements_[a].f.lead.TotalDegree() < elements_[b].f.lead.TotalDegree();
+        });
+        std::vector<Element> minimal;
+        for (auto index : by_degree) {
+            if (!FindDivisor(elements_[index].f.lead, minimal)) {
+                minimal.push_back(elements_[index]);
+            }
+        }
+
+        std::vector<PolynomType> basis;
+        basis.reserve(minimal.size());
+        for (const auto& element : minimal) {
+            // the tail is smaller than the lead, so it is not reduced by the element itself
+            Binomial f = ReduceTail(element.f, minimal);
+            std::vector<Term<Field>> terms;
+            terms.reserve(f.size);
+            terms.push_back(std::move(f.lead));
+            if (f.size == 2) {
+                terms.push_back(std::move(f.tail));
+            }
+            basis.push_back(PolynomType::BuildFromOrderedTerms(std::move(terms), order_));
+        }
+        return basis;
+    }
+
+    std::vector<Element> elements_;
+    [[no_unique_address]] Order order_;
+};
+
+// The reduced Groebner basis of generators of a special shape by the algorithm for that
+// shape, in no particular order. std::nullopt for generators of no special shape and if the
+// context stops the computation.
+template <typename Field, typename Order>
+std::optional<std::vector<Polynom<Field, Order>>> ReducedBasisOfShape(
+    const std::vector<Polynom<Field, Order>>& generators, const Order& order,
+    ComputationContext& context) {
+
+    switch (DetectShape(generators)) {
+        case IdealShape::kLinear:
+            return LinearReducedBasis(generators, order, context);
+        case IdealShape::kUnivariate:
+            return UnivariateReducedBasis(generators, order, context);
+        case IdealShape::kBinomial:
+            return BinomialBasisBuilder<Field, Order>(order).Build(generators, context);
+        default:
+            return std::nullopt;
+    }
+}
+
+}  // namespace groebner_basis
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <vector>
+#include "context.h"
+#include "functions.h"
+#include "groebner_basis.h"
+
+namespace groebner_basis {
+
+// The reduced Groebner basis of generators handed out element by element. For homogeneous
+// generators and a degree order the basis is built by the normal strategy: generators and
+// S-pairs are processed by increasing degree, and once a degree is done its elements are final
+// and are given out before the next degree starts. Otherwise the whole basis is built by
+// BuildGreobnerBasis before the first element. Either way the elements are those of
+// BuildGreobnerBasis; in the first case they come by increasing degree.
+template <typename Field, typename Order = GrevLexOrder>
+class GroebnerBasisStream {
+public:
+    using PolynomType = Polynom<Field, Order>;
+    using Set = PolynomialsSet<Field, Order>;
+
+    explicit GroebnerBasisStream(const Set &generators)
+        : generators_(generators.begin(), generators.end()), basis_(generators.GetOrder()) {
+
+        incremental_ = DegreeOrder<Order> &&
+                       std::all_of(generators_.begin(), generators_.end(), IsHomogeneous);
+        if (incremental_) {
+            for (size_t k = 0; k < generators_.size(); ++k) {
+                if (!generators_[k].IsZero()) {
+                    Push(Degree(generators_[k]), k, kGenerator);
+                }
+            }
+        }
+    }
+
+    // Whether the elements come degree by degree
+    bool IsIncremental() const {
+        return incremental_;
+    }
+
+    std::optional<PolynomType> Next() {
+        ComputationContext context;
+        return Next(context);
+    }
+
+    // std::nullopt after the last element or when the context stops the computation. A stopped
+    // stream continues where it was with the next call.
+    std::optional<PolynomType> Next(ComputationContext &context) {
+        while (emitted_ == output_.size()) {
+            output_.clear();
+            emitted_ = 0;
+            if (!(incremental_ ? NextDegree(context) : BuildAll(context))) {
+                return std::nullopt;
+            }
+        }
+        return output_[emitted_++];
+    }
+
+    class Iterator {
+    public:
+        using value_type = PolynomType;
+        using difference_type = std::ptrdiff_t;
+
+        explicit Iterator(GroebnerBasisStream *stream) : stream_(stream), current_(stream->Next()) {
+        }
+
+        const PolynomType &operator*() const {
+            return current_.value();
+        }
+
+        const PolynomType *operator->() const {
+            return &current_.value();
+        }
+
+        Iterator &operator++() {
+            current_ = stream_->Next();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const {
+            return !current_;
+        }
+
+    private:
+        GroebnerBasisStream *stream_;
+        std::optional<PolynomType> current_;
+    };
+
+    Iterator begin() {  // NOLINT
+        return Iterator(this);
+    }
+
+    std::default_sentinel_t end() {  // NOLINT
+        return {};
+    }
+
+private:
+    static constexpr uint32_t kGenerator = std::numeric_limits<uint32_t>::max();
+
+    // generators_[i] if j is kGenerator, otherwise the S-polynomial of elements i and j
+    struct Item {
+        size_t degree;
+        uint64_t sequence;  // keeps the processing order independent of the heap
+        uint32_t i;
+        uint32_t j;
+
+        bool operator>(const Item &other) const {
+            return degree != other.degree ? degree > other.degree : sequence > other.sequence;
+        }
+    };
+
+    static size_t Degree(const PolynomType &f) {
+        return f.GetLargestTerm().TotalDegree();
+    }
+
+    static bool IsHomogeneous(const PolynomType &f) {
+        return f.IsZero() || std::all_of(f.begin(), f.end(), [&](const Term<Field> &t) {
+                   return t.TotalDegree() == Degree(f);
+               });
+    }
+
+    const PolynomType &Element(size_t index) const {
+        return *(basis_.begin() + index);
+    }
+
+    void Push(size_t degree, size_t i, size_t j) {
+        queue_.push({degree, sequence_++, static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+    }
+
+    // Processes the lowest pending degree and puts its elements to output_
+    bool NextDegree(ComputationContext &context) {
+
+        if (queue_.empty()) {
+            return false;
+        }
+
+        size_t degree = queue_.top().degree;
+        while (!queue_.empty() && queue_.top().degree == degree) {
+            if (context.ShouldStop()) {
+                return false;
+            }
+
+            Item item = queue_.top();
+            PolynomType f = item.j == kGenerator ? generators_[item.i]
+                                                 : SPolynom(Element(item.i), Element(item.j));
+            auto remainder = basis_.Reduce(f, context);
+            if (context.GetStatus() != ComputationStatus::kCompleted) {
+                return false;
+            }
+            queue_.pop();
+
+            f = remainder.value_or(f);
+            if (f.IsZero()) {
+                continue;
+            }
+
+            // every new element is top reduced by the others, so the set stays minimal and the
+            // new pairs have larger degrees
+            size_t index = basis_.Size();
+            basis_.Add(f);
+            const Monom &leading = Element(index).GetLargestTerm();
+            for (size_t k = 0; k < index; ++k) {
+                const Monom &other = Element(k).GetLargestTerm();
+                auto lcm = LCM(leading, other);
+                if (lcm.TotalDegree() != leading.TotalDegree() + other.TotalDegree()) {
+                    Push(lcm.TotalDegree(), index, k);
+                }
+            }
+            fresh_.push_back(index);
+        }
+
+        // the elements of this degree are final up to their tails, which are reduced now
+        // by everything of degree at most this one, that is the whole set
+        for (auto index : fresh_) {
+            auto &g = *(basis_.begin() + index);
+            PolynomType leading(g.GetLargestTerm(), g.GetOrder());
+            PolynomType tail = g - leading;
+            if (auto reduced = basis_.Reduce(tail)) {
+                g = leading + reduced.value();
+            }
+            output_.push_back(g);
+        }
+        fresh_.clear();
+        std::sort(output_.begin(), output_.end());
+        return true;
+    }
+
+    bool BuildAll(ComputationContext &context) {
+
+        if (built_) {
+            return false;
+        }
+
+        Set set(basis_.GetOrder());
+        for (const auto &f : generators_) {
+            set.Add(f);
+        }
+        if (set.BuildGreobnerBasis(context) != ComputationStatus::kCompleted) {
+            return false;
+        }
+        output_.assign(set.begin(), set.end());
+        built_ = true;
+        return true;
+    }
+
+    std::vector<PolynomType> generators_;
+    Set basis_;
+    bool incremental_ = false;
+    bool built_ = false;
+
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue_;
+    uint64_t sequence_ = 0;
+    std::vector<size_t> fresh_;  // elements added in the current degree
+
+    std::vector<PolynomType> output_;
+    size_t emitted_ = 0;
+};
+
+}  // namespace groebner_basis
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "orders.h"
 
 namespace groebner_basis {
@@ -17,6 +19,10 @@ public:
         return coef_;
     }
 
+    void SetCoefficient(const Field& coefficient) {
+        coef_ = coefficient;
+    }
+
     const Monom& GetMonom() const {
         return *this;
     }
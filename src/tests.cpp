@@ -1,9 +1,22 @@
 #include "groebner_basis.h"
+#include "batch.h"
+#include "boolean.h"
+#include "cache.h"
+#include "context.h"
+#include "evaluation.h"
+#include "kernels.h"
+#include "rational.h"
+#include "reducer.h"
+#include "stream.h"
 #include "types.h"
 
 #include <gtest/gtest.h>
 #include <boost/rational.hpp>
+#include <filesystem>
 #include <fstream>
+#include <random>
+#include <sstream>
+#include <unordered_set>
 
 namespace {
 
@@ -18,17 +31,17 @@ void Check(gb::PolynomialsSet<ModInt>& find, gb::PolynomialsSet<ModInt>& ans) {
     EXPECT_EQ(find, ans);
 }
 
-void CheckFromFile() {
+// The ideals of tests.txt with their reduced Groebner bases
+std::vector<std::pair<gb::PolynomialsSet<ModInt>, gb::PolynomialsSet<ModInt>>> ReadTests() {
     int state;
     std::string str;
 
     gb::PolynomialsSet<ModInt> find, ans;
+    std::vector<std::pair<gb::PolynomialsSet<ModInt>, gb::PolynomialsSet<ModInt>>> tests;
     std::ifstream file("../tests.txt");
 
     EXPECT_EQ(file.is_open(), true);
 
-    int num = 0;
-
     while (file >> str) {
 
         if (str == "test") {
@@ -40,7 +53,7 @@ void CheckFromFile() {
             continue;
         }
         if (str == "calc") {
-            Check(find, ans);
+            tests.emplace_back(find, ans);
             find.Clear();
             ans.Clear();
             continue;
@@ -54,6 +67,70 @@ void CheckFromFile() {
             ans.Add(poly);
         }
     }
+    return tests;
+}
+
+void CheckFromFile() {
+    for (auto& [find, ans] : ReadTests()) {
+        Check(find, ans);
+    }
+}
+
+gb::PolynomialsSet<ModInt> BuildCyclic(size_t n) {
+    gb::PolynomialsSet<ModInt> s;
+
+    for (size_t i = 1; i < n; ++i) {
+        std::vector<gb::Monom::Degree> degrees(n, 0);
+        std::fill(degrees.begin(), degrees.begin() + i, 1);
+
+        gb::Polynom<ModInt>::Builder poly;
+        for (size_t j = 0; j < n; ++j) {
+            poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(degrees));
+            degrees[j] = 0;
+            degrees[(j + i) % n] = 1;
+        }
+        s.Add(poly.BuildPolynom());
+    }
+
+    std::vector<gb::Monom::Degree> degrees(n, 1);
+    gb::Polynom<ModInt>::Builder poly;
+    poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(degrees));
+    poly.AddTerm(-1, {});
+    s.Add(poly.BuildPolynom());
+
+    return s;
+}
+
+gb::Polynom<ModInt> RandomPolynom(std::mt19937& rng, size_t vars, size_t terms,
+                                  gb::Monom::Degree max_degree) {
+    gb::Polynom<ModInt>::Builder poly;
+
+    for (size_t i = 0; i < terms; ++i) {
+        std::vector<gb::Monom::Degree> degrees(vars);
+        for (auto& degree : degrees) {
+            degree = rng() % (max_degree + 1);
+        }
+        poly.AddTerm(static_cast<int64_t>(rng() % 1000) - 500,
+                     gb::Monom::BuildFromVectorDegrees(degrees));
+    }
+
+    return poly.BuildPolynom();
+}
+
+template <typename ToOrder, typename FromOrder>
+gb::PolynomialsSet<ModInt, ToOrder> ConvertOrder(const gb::PolynomialsSet<ModInt, FromOrder>& set,
+                                                 const ToOrder& order) {
+    gb::PolynomialsSet<ModInt, ToOrder> result(order);
+
+    for (const auto& f : set) {
+        typename gb::Polynom<ModInt, ToOrder>::Builder poly(order);
+        for (const auto& t : f) {
+            poly.AddTerm(t);
+        }
+        result.Add(poly.BuildPolynom());
+    }
+
+    return result;
 }
 }  // namespace
 
@@ -61,6 +138,1184 @@ TEST(GroebnerBasisTest, Stress) {
     CheckFromFile();
 }
 
+TEST(ReducerTest, NormalFormsMatchReduce) {
+    auto basis = BuildCyclic(4);
+    basis.BuildGreobnerBasis();
+    gb::Reducer<ModInt> reducer(basis);
+
+    std::mt19937 rng(26);
+    std::vector<gb::Polynom<ModInt>> batch;
+    for (size_t i = 0; i < 200; ++i) {
+        batch.push_back(RandomPolynom(rng, 4, 6, 4));
+    }
+
+    gb::ThreadPool pool(4);
+    auto normal_forms = reducer.NormalForms(batch, pool);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_EQ(normal_forms[i], basis.Reduce(batch[i]).value_or(batch[i]));
+        EXPECT_EQ(normal_forms[i], reducer.NormalForm(batch[i]));
+    }
+}
+
+TEST(ReducerTest, WorkspaceSharedByReducers) {
+    // the same number of reductors, so the cached multiples of one must not serve the other
+    using P = gb::Polynom<ModInt>;
+    gb::PolynomialsSet<ModInt> first, second;
+    first.Add(P::BuildFromString("x^2-2"));
+    first.Add(P::BuildFromString("y^2-3"));
+    second.Add(P::BuildFromString("x^2-5"));
+    second.Add(P::BuildFromString("y^2-7"));
+    gb::Reducer<ModInt> first_reducer(first), second_reducer(second);
+
+    std::mt19937 rng(40);
+    gb::Reducer<ModInt>::Workspace workspace;
+    for (size_t i = 0; i < 50; ++i) {
+        auto f = RandomPolynom(rng, 2, 6, 4);
+        EXPECT_EQ(first_reducer.NormalForm(f, workspace), first_reducer.NormalForm(f));
+        EXPECT_EQ(second_reducer.NormalForm(f, workspace), second_reducer.NormalForm(f));
+    }
+}
+
+TEST(ReducerTest, IsMember) {
+    auto basis = BuildCyclic(4);
+    basis.BuildGreobnerBasis();
+    gb::Reducer<ModInt> reducer(basis);
+
+    std::mt19937 rng(27);
+    std::vector<gb::Polynom<ModInt>> batch;
+    for (size_t i = 0; i < 50; ++i) {
+        gb::Polynom<ModInt> member;
+        for (const auto& g : basis) {
+            member = member + RandomPolynom(rng, 4, 3, 2) * g;
+        }
+        batch.push_back(member);
+        batch.push_back(member + RandomPolynom(rng, 4, 1, 1));
+    }
+
+    gb::ThreadPool pool(3);
+    auto members = reducer.AreMembers(batch, pool);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        bool expected = reducer.NormalForm(batch[i]).IsZero();
+        EXPECT_EQ(members[i], expected);
+        EXPECT_EQ(reducer.IsMember(batch[i]), expected);
+        if (i % 2 == 0) {
+            EXPECT_TRUE(expected);
+        }
+    }
+}
+
+TEST(ComputationContextTest, Limits) {
+    auto cancelled = BuildCyclic(4);
+    gb::CancellationToken token;
+    token.Cancel();
+    gb::ComputationContext cancel_context;
+    cancel_context.SetCancellationToken(token);
+    EXPECT_EQ(cancelled.BuildGreobnerBasis(cancel_context), gb::ComputationStatus::kCancelled);
+    EXPECT_EQ(cancelled, BuildCyclic(4));
+
+    auto late = BuildCyclic(4);
+    gb::ComputationContext deadline_context;
+    deadline_context.SetDeadline(gb::ComputationContext::Clock::now());
+    EXPECT_EQ(late.BuildGreobnerBasis(deadline_context),
+              gb::ComputationStatus::kDeadlineExceeded);
+
+    auto large = BuildCyclic(5);
+    gb::ComputationContext budget_context;
+    budget_context.SetTermsBudget(100);
+    EXPECT_EQ(large.BuildGreobnerBasis(budget_context), gb::ComputationStatus::kBudgetExceeded);
+    EXPECT_GE(large.Size(), BuildCyclic(5).Size());
+}
+
+TEST(ComputationContextTest, Progress) {
+    auto basis = BuildCyclic(4);
+    auto expected = basis;
+    expected.BuildGreobnerBasis();
+
+    std::vector<gb::Progress> reports;
+    gb::ComputationContext context;
+    context.SetProgressCallback([&](const gb::Progress& progress) { reports.push_back(progress); },
+                                2);
+
+    EXPECT_EQ(basis.BuildGreobnerBasis(context), gb::ComputationStatus::kCompleted);
+    EXPECT_EQ(basis, expected);
+    ASSERT_FALSE(reports.empty());
+    for (const auto& progress : reports) {
+        EXPECT_GT(progress.degree, 0u);
+        EXPECT_GE(progress.basis_size, 4u);
+    }
+}
+
+TEST(CheckpointTest, ResumeFromSnapshot) {
+    auto expected = BuildCyclic(5);
+    expected.BuildGreobnerBasis();
+
+    auto interrupted = BuildCyclic(5);
+    gb::CancellationToken token;
+    gb::ComputationContext context;
+    context.SetCancellationToken(token);
+    context.SetProgressCallback([&](const gb::Progress&) { token.Cancel(); }, 20);
+    ASSERT_EQ(interrupted.BuildGreobnerBasis(context), gb::ComputationStatus::kCancelled);
+
+    std::stringstream snapshot;
+    interrupted.SaveCheckpoint(snapshot);
+    EXPECT_EQ(snapshot.str().find("field modulus 998244353\norder grevlex\n"),
+              snapshot.str().find('\n') + 1);
+
+    gb::PolynomialsSet<ModInt> resumed;
+    ASSERT_TRUE(resumed.LoadCheckpoint(snapshot));
+    EXPECT_EQ(resumed, interrupted);
+    resumed.BuildGreobnerBasis();
+    EXPECT_EQ(resumed, expected);
+
+    std::stringstream other_field(snapshot.str());
+    gb::PolynomialsSet<gb::Modulus<std::int64_t, 239>> wrong;
+    EXPECT_FALSE(wrong.LoadCheckpoint(other_field));
+}
+
+TEST(CheckpointTest, AsyncWriter) {
+    auto expected = BuildCyclic(5);
+    expected.BuildGreobnerBasis();
+
+    auto path = std::filesystem::temp_directory_path() / "groebner_basis_checkpoint_test.txt";
+    auto interrupted = BuildCyclic(5);
+    {
+        gb::CheckpointWriter writer(path.string());
+        gb::CancellationToken token;
+        gb::ComputationContext context;
+        context.SetCancellationToken(token);
+        context.SetCheckpointWriter(writer, std::chrono::seconds(0));
+        context.SetProgressCallback([&](const gb::Progress&) { token.Cancel(); }, 30);
+
+        ASSERT_EQ(interrupted.BuildGreobnerBasis(context), gb::ComputationStatus::kCancelled);
+        writer.Flush();
+        EXPECT_GT(writer.WrittenCount(), 0u);
+        EXPECT_FALSE(writer.HasFailed());
+    }
+
+    std::ifstream file(path);
+    gb::PolynomialsSet<ModInt> resumed;
+    ASSERT_TRUE(resumed.LoadCheckpoint(file));
+    EXPECT_EQ(resumed, interrupted);
+    resumed.BuildGreobnerBasis();
+    EXPECT_EQ(resumed, expected);
+
+    std::filesystem::remove(path);
+}
+
+TEST(OrdersTest, MatrixOrders) {
+    gb::WeightedOrder weighted({2, 1, 1});
+    EXPECT_TRUE(weighted(gb::Monom{0, 2}, gb::Monom{1}));
+    EXPECT_TRUE(weighted(gb::Monom{1}, gb::Monom{0, 1}));
+    EXPECT_TRUE(weighted(gb::Monom{0, 1}, gb::Monom{0, 0, 1}));
+
+    gb::BlockOrder block({1, 2});
+    EXPECT_TRUE(block(gb::Monom{1}, gb::Monom{0, 5, 5}));
+    EXPECT_TRUE(block(gb::Monom{0, 1, 1}, gb::Monom{0, 0, 1}));
+
+    auto grevlex = BuildCyclic(4);
+    grevlex.BuildGreobnerBasis();
+
+    auto as_weighted = ConvertOrder(BuildCyclic(4), gb::WeightedOrder({1, 1, 1, 1}));
+    as_weighted.BuildGreobnerBasis();
+    auto expected = ConvertOrder(grevlex, as_weighted.GetOrder());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(as_weighted, expected);
+
+    auto as_block = ConvertOrder(BuildCyclic(4), gb::BlockOrder({4}));
+    as_block.BuildGreobnerBasis();
+    gb::MatrixOrder block_rows = as_block.GetOrder();
+    auto expected_block = ConvertOrder(grevlex, block_rows);
+    std::sort(expected_block.begin(), expected_block.end());
+    EXPECT_EQ(ConvertOrder(as_block, block_rows), expected_block);
+}
+
+TEST(OrdersTest, MatrixLex) {
+    gb::PolynomialsSet<ModInt, gb::LexOrder> lex;
+    for (const auto& f : BuildCyclic(3)) {
+        gb::Polynom<ModInt, gb::LexOrder>::Builder poly;
+        for (const auto& t : f) {
+            poly.AddTerm(t);
+        }
+        lex.Add(poly.BuildPolynom());
+    }
+    lex.BuildGreobnerBasis();
+
+    gb::MatrixOrder identity({{1, 0, 0}, {0, 1, 0}, {0, 0, 1}});
+    auto matrix = ConvertOrder(BuildCyclic(3), identity);
+    matrix.BuildGreobnerBasis();
+
+    auto expected = ConvertOrder(lex, identity);
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(matrix, expected);
+
+    std::stringstream snapshot;
+    matrix.SaveCheckpoint(snapshot);
+    gb::PolynomialsSet<ModInt, gb::MatrixOrder> other(
+        gb::MatrixOrder({{1, 1, 1}, {0, 0, -1}, {0, -1, 0}}));
+    EXPECT_FALSE(other.LoadCheckpoint(snapshot));
+}
+
+gb::PolynomialsSet<ModInt> BuildFromStrings(std::initializer_list<std::string> polys) {
+    gb::PolynomialsSet<ModInt> set;
+    for (const auto& str : polys) {
+        set.Add(gb::Polynom<ModInt>::BuildFromString(str));
+    }
+    set.BuildGreobnerBasis();
+    return set;
+}
+
+TEST(IdealsTest, Eliminate) {
+    auto ideal = BuildCyclic(3);
+
+    gb::PolynomialsSet<ModInt, gb::LexOrder> lex;
+    for (const auto& f : ideal) {
+        lex.Add(gb::ChangeOrder(f, gb::LexOrder()));
+    }
+    lex.BuildGreobnerBasis();
+
+    gb::PolynomialsSet<ModInt> expected;
+    for (const auto& f : lex) {
+        if (std::all_of(f.begin(), f.end(), [](const auto& t) { return t.Deg(0) == 0; })) {
+            expected.Add(gb::ChangeOrder(f, gb::GrevLexOrder()));
+        }
+    }
+    expected.BuildGreobnerBasis();
+
+    auto eliminated = ideal.Eliminate({0});
+    EXPECT_EQ(eliminated, expected);
+    EXPECT_GT(eliminated.Size(), 0u);
+
+    auto expected_grlex = ConvertOrder(expected, gb::GrLexOrder());
+    expected_grlex.BuildGreobnerBasis();
+    EXPECT_EQ(ConvertOrder(ideal, gb::GrLexOrder()).Eliminate({0}), expected_grlex);
+}
+
+TEST(IdealsTest, SaturateAndIntersect) {
+    auto ideal = BuildFromStrings({"x^2y", "xy^2"});
+    EXPECT_EQ(ideal.Saturate(gb::Polynom<ModInt>::BuildFromString("x")),
+              BuildFromStrings({"y"}));
+    EXPECT_EQ(ideal.Saturate(gb::Polynom<ModInt>::BuildFromString("z")), ideal);
+
+    EXPECT_EQ(gb::PolynomialsSet<ModInt>::Intersect(BuildFromStrings({"x"}),
+                                                    BuildFromStrings({"y"})),
+              BuildFromStrings({"xy"}));
+    EXPECT_EQ(gb::PolynomialsSet<ModInt>::Intersect(BuildFromStrings({"x^2", "y"}),
+                                                    BuildFromStrings({"x", "y^2"})),
+              BuildFromStrings({"x^2", "xy", "y^2"}));
+}
+
+// The new variable of Saturate and Intersect has no column in a matrix order
+template <typename Order>
+void CheckSaturateAndIntersect(const Order& order) {
+    auto build = [&](std::initializer_list<std::string> polys) {
+        auto set = ConvertOrder(BuildFromStrings(polys), order);
+        set.BuildGreobnerBasis();
+        return set;
+    };
+    auto x = *ConvertOrder(BuildFromStrings({"x"}), order).begin();
+
+    EXPECT_EQ(build({"x^2y+xy^2"}).Saturate(x), build({"xy+y^2"}));
+    using Set = gb::PolynomialsSet<ModInt, Order>;
+    EXPECT_EQ(Set::Intersect(build({"x^2", "y"}), build({"x", "y^2"})),
+              build({"x^2", "xy", "y^2"}));
+}
+
+TEST(IdealsTest, SaturateAndIntersectInMatrixOrders) {
+    CheckSaturateAndIntersect(gb::WeightedOrder({1, 1}));
+    CheckSaturateAndIntersect(gb::BlockOrder({1, 1}));
+    CheckSaturateAndIntersect(gb::MatrixOrder({{1, 1}, {1, 0}}));
+}
+
+TEST(InterReductionTest, ParallelMatchesSequential) {
+    auto sequential = BuildCyclic(5);
+    sequential.BuildGreobnerBasis();
+
+    auto parallel = BuildCyclic(5);
+    gb::ThreadPool pool(4);
+    gb::ComputationContext context;
+    context.SetThreadPool(pool);
+    EXPECT_EQ(parallel.BuildGreobnerBasis(context), gb::ComputationStatus::kCompleted);
+    EXPECT_EQ(parallel, sequential);
+
+    auto reduced = sequential;
+    reduced.AutoReduction();
+    std::sort(reduced.begin(), reduced.end());
+    EXPECT_EQ(reduced, sequential);
+}
+
+TEST(ReductionModeTest, TopMatchesFull) {
+    auto top = BuildCyclic(5);
+    EXPECT_EQ(top.GetReductionMode(), gb::ReductionMode::kTop);
+    top.BuildGreobnerBasis();
+
+    auto full = BuildCyclic(5);
+    full.SetReductionMode(gb::ReductionMode::kFull);
+    full.BuildGreobnerBasis();
+
+    EXPECT_EQ(top, full);
+}
+
+TEST(PolynomTest, InPlaceOperations) {
+    std::mt19937 rng(33);
+    for (size_t i = 0; i < 100; ++i) {
+        auto f = RandomPolynom(rng, 3, 8, 4);
+        auto g = RandomPolynom(rng, 3, 5, 3);
+        if (f.IsZero() || g.IsZero()) {
+            continue;
+        }
+        gb::Term<ModInt> t(ModInt(5), g.GetLargestTerm().GetMonom());
+
+        auto copy = f;
+        auto expected = f - t * g;
+        copy.SubtractMultiple(t, g);
+        EXPECT_EQ(copy, expected);
+        EXPECT_EQ(f, expected + t * g);
+
+        auto scaled = f;
+        scaled.Scale(ModInt(3));
+        EXPECT_EQ(scaled, f * gb::Term<ModInt>(ModInt(3)));
+
+        auto negated = f;
+        negated.Negate();
+        EXPECT_EQ(negated + f, gb::Polynom<ModInt>());
+
+        auto monic = f;
+        monic.MakeMonic();
+        EXPECT_EQ(monic.GetLargestTerm().GetCoefficient(), ModInt(1));
+    }
+
+    // an owned polynomial is changed without copying its terms
+    auto f = gb::Polynom<ModInt>::BuildFromString("2x^2+3xy+4");
+    const auto* terms = &*f.begin();
+    f.Scale(ModInt(7));
+    f.Negate();
+    EXPECT_EQ(&*f.begin(), terms);
+    EXPECT_EQ(f, gb::Polynom<ModInt>::BuildFromString("-14x^2-21xy-28"));
+}
+
+template <typename Simd>
+void CheckKernels(uint32_t p) {
+    std::mt19937 rng(p);
+
+    for (size_t size = 0; size < 40; ++size) {
+        std::vector<uint32_t> x(size), y(size);
+        for (size_t i = 0; i < size; ++i) {
+            x[i] = rng() % p;
+            y[i] = rng() % p;
+        }
+        uint32_t c = rng() % p;
+
+        auto axpy = y;
+        gb::AxpyMod<Simd>(axpy.data(), x.data(), size, c, p);
+        auto scaled = y;
+        gb::ScaleMod<Simd>(scaled.data(), size, c, p);
+
+        for (size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(axpy[i], (y[i] + static_cast<uint64_t>(c) * x[i]) % p);
+            EXPECT_EQ(scaled[i], static_cast<uint64_t>(c) * y[i] % p);
+        }
+
+        std::vector<uint64_t> expected(y.begin(), y.end());
+        gb::DenseRowAccumulator<Simd> row(size, p);
+        row.Assign(y.data());
+        for (uint32_t k = 0; k < 50; ++k) {
+            uint32_t factor = (p - 1 - k) % p;
+            row.SubtractMultiple(x.data(), factor);
+            for (size_t i = 0; i < size; ++i) {
+                expected[i] = (expected[i] + (p - factor) % p * static_cast<uint64_t>(x[i])) % p;
+            }
+        }
+        std::vector<uint32_t> result(size);
+        row.Extract(result.data());
+        EXPECT_EQ(std::vector<uint64_t>(result.begin(), result.end()), expected);
+    }
+}
+
+TEST(KernelsTest, MatchScalarArithmetic) {
+    for (uint32_t p : {2u, 239u, 998244353u, 2147483647u}) {
+        CheckKernels<gb::simd::Scalar>(p);
+        CheckKernels<gb::simd::Native>(p);
+    }
+
+    using SmallModInt = gb::Modulus<std::int32_t, 998244353>;
+    std::vector<SmallModInt> x = {1, 2, 3, 4, 5, 6, 7, 8, 9}, y(9, SmallModInt(998244352));
+    gb::Axpy(y.data(), x.data(), y.size(), SmallModInt(2));
+    gb::Scale(y.data(), y.size(), SmallModInt(3));
+    for (size_t i = 0; i < y.size(); ++i) {
+        EXPECT_EQ(y[i].GetValue(), 3 * (2 * static_cast<int32_t>(i + 1) - 1));
+    }
+}
+
+template <typename Order>
+void CheckBooleanAgainstModulus(size_t vars, std::mt19937& rng) {
+    using GF2 = gb::Modulus<int, 2>;
+    using BooleanSet = gb::BooleanPolynomialsSet<64, Order>;
+
+    BooleanSet boolean;
+    gb::PolynomialsSet<GF2, Order> generic;
+
+    for (size_t k = 0; k < vars - 1; ++k) {
+        typename gb::Polynom<GF2, Order>::Builder poly;
+        for (size_t t = 0; t < 4; ++t) {
+            std::vector<gb::Monom::Degree> degrees(vars);
+            for (auto& degree : degrees) {
+                degree = rng() % 4 == 0;
+            }
+            poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        auto f = poly.BuildPolynom();
+        boolean.Add(BooleanSet::PolynomType::FromPolynom(f));
+        generic.Add(f);
+    }
+
+    std::vector<gb::Polynom<GF2, Order>> field_equations;
+    for (size_t i = 0; i < vars; ++i) {
+        std::vector<gb::Monom::Degree> square(vars), variable(vars);
+        square[i] = 2;
+        variable[i] = 1;
+        typename gb::Polynom<GF2, Order>::Builder poly;
+        poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(square));
+        poly.AddTerm(1, gb::Monom::BuildFromVectorDegrees(variable));
+        field_equations.push_back(poly.BuildPolynom());
+        generic.Add(field_equations.back());
+    }
+
+    boolean.BuildGreobnerBasis();
+    generic.BuildGreobnerBasis();
+
+    std::vector<gb::Polynom<GF2, Order>> expected, found;
+    for (const auto& f : generic) {
+        if (std::find(field_equations.begin(), field_equations.end(), f) ==
+            field_equations.end()) {
+            expected.push_back(f);
+        }
+    }
+    for (const auto& f : boolean) {
+        found.push_back(f.template ToPolynom<GF2>());
+    }
+    EXPECT_EQ(found, expected);
+}
+
+TEST(BooleanTest, MatchesModulusWithFieldEquations) {
+    std::mt19937 rng(35);
+    for (size_t i = 0; i < 30; ++i) {
+        CheckBooleanAgainstModulus<gb::GrevLexOrder>(3 + i % 4, rng);
+        CheckBooleanAgainstModulus<gb::LexOrder>(3 + i % 4, rng);
+    }
+
+    using B = gb::BooleanPolynom<>;
+    EXPECT_EQ(B::BuildFromString("xy") + B::BuildFromString("xy+x"), B::BuildFromString("x"));
+    EXPECT_EQ(B::BuildFromString("x+y") * B::BuildFromString("x+y"), B::BuildFromString("x+y"));
+    EXPECT_EQ(B::BuildFromString("2x^3+y^2"), B::BuildFromString("y"));
+}
+
+TEST(EvaluatorTest, MatchesTermByTerm) {
+    std::mt19937 rng(36);
+    auto basis = BuildCyclic(4);
+    basis.BuildGreobnerBasis();
+    std::vector<gb::Polynom<ModInt>> polynoms(basis.begin(), basis.end());
+    for (size_t i = 0; i < 20; ++i) {
+        polynoms.push_back(RandomPolynom(rng, 4, 10, 5));
+    }
+    polynoms.push_back(gb::Polynom<ModInt>());
+
+    gb::Evaluator<ModInt> evaluator(polynoms);
+    EXPECT_EQ(evaluator.PolynomsCount(), polynoms.size());
+    EXPECT_EQ(evaluator.VariablesCount(), 4);
+
+    size_t count = 3 * gb::Evaluator<ModInt>::kBlockSize + 5;
+    std::vector<ModInt> points;
+    for (size_t i = 0; i < count * 4; ++i) {
+        points.push_back(static_cast<int64_t>(rng()));
+    }
+
+    gb::ThreadPool pool(4);
+    auto values = evaluator.EvaluateBatch(points);
+    EXPECT_EQ(evaluator.EvaluateBatch(points, pool), values);
+
+    for (size_t p = 0; p < count; ++p) {
+        std::vector<ModInt> point(points.begin() + p * 4, points.begin() + (p + 1) * 4);
+        auto single = evaluator.Evaluate(point);
+        for (size_t f = 0; f < polynoms.size(); ++f) {
+            EXPECT_EQ(values[p * polynoms.size() + f], polynoms[f].Evaluate(point));
+            EXPECT_EQ(single[f], values[p * polynoms.size() + f]);
+        }
+    }
+
+    gb::Evaluator<ModInt> single(gb::Polynom<ModInt>::BuildFromString("x^2y+xy+3"));
+    EXPECT_EQ(single.InstructionsCount(), 4);  // x, x^2, x^2y and xy
+    EXPECT_EQ(single.Evaluate({2, 5}), std::vector<ModInt>{33});
+}
+
+// The same supports with random nonzero coefficients
+gb::PolynomialsSet<ModInt> RandomizeCoefficients(const gb::PolynomialsSet<ModInt>& set,
+                                                 std::mt19937& rng) {
+    gb::PolynomialsSet<ModInt> result;
+    for (const auto& f : set) {
+        gb::Polynom<ModInt>::Builder poly;
+        for (const auto& t : f) {
+            poly.AddTerm(static_cast<int64_t>(rng() % 1000) + 1, t.GetMonom());
+        }
+        result.Add(poly.BuildPolynom());
+    }
+    return result;
+}
+
+TEST(TraceTest, ReplayMatchesBuild) {
+    std::mt19937 rng(37);
+    auto cyclic = BuildCyclic(5);
+
+    gb::GroebnerTrace trace;
+    auto recorded = RandomizeCoefficients(cyclic, rng);
+    recorded.SetReductionMode(gb::ReductionMode::kFull);
+    gb::ComputationContext context;
+    EXPECT_EQ(recorded.BuildGreobnerBasis(context, trace), gb::ComputationStatus::kCompleted);
+    EXPECT_FALSE(trace.IsEmpty());
+    EXPECT_EQ(recorded.GetReductionMode(), gb::ReductionMode::kFull);
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto replayed = RandomizeCoefficients(cyclic, rng);
+        auto built = replayed;
+        EXPECT_TRUE(replayed.ReplayGroebnerBasis(trace));
+        built.BuildGreobnerBasis();
+        EXPECT_EQ(replayed, built);
+    }
+
+    // other supports are rejected before anything is computed
+    auto other = BuildCyclic(4);
+    auto expected = other;
+    expected.BuildGreobnerBasis();
+    EXPECT_FALSE(other.ReplayGroebnerBasis(trace));
+    EXPECT_EQ(other, expected);
+}
+
+TEST(TraceTest, DivergenceFallsBack) {
+    gb::GroebnerTrace trace;
+    gb::ComputationContext context;
+
+    gb::PolynomialsSet<ModInt> generic = {gb::Polynom<ModInt>::BuildFromString("x+y"),
+                                          gb::Polynom<ModInt>::BuildFromString("x+2y")};
+    generic.BuildGreobnerBasis(context, trace);
+    EXPECT_EQ(trace.pairs.size(), 1);
+
+    // the remainder of the only pair is zero here
+    gb::PolynomialsSet<ModInt> special = {gb::Polynom<ModInt>::BuildFromString("x+y"),
+                                          gb::Polynom<ModInt>::BuildFromString("2x+2y")};
+    EXPECT_FALSE(special.ReplayGroebnerBasis(trace));
+    EXPECT_EQ(special, gb::PolynomialsSet<ModInt>{gb::Polynom<ModInt>::BuildFromString("x+y")});
+}
+
+TEST(CacheTest, PolynomHash) {
+    auto f = gb::Polynom<ModInt>::BuildFromString("2x^2+3xy+4");
+    auto copy = f;
+    EXPECT_EQ(f.Hash(), copy.Hash());
+    EXPECT_EQ(f.Hash(), gb::Polynom<ModInt>::BuildFromString("2x^2+3xy+4").Hash());
+
+    // the cached hash is dropped when the terms change
+    copy.Scale(2);
+    EXPECT_EQ(copy.Hash(), gb::Polynom<ModInt>::BuildFromString("4x^2+6xy+8").Hash());
+    EXPECT_EQ(f.Hash(), gb::Polynom<ModInt>::BuildFromString("2x^2+3xy+4").Hash());
+    EXPECT_NE(f, copy);
+
+    std::unordered_set<gb::Polynom<ModInt>> set = {f, copy, f};
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(gb::Polynom<ModInt>::BuildFromString("4x^2+6xy+8")));
+}
+
+TEST(CacheTest, ReusesNormalForms) {
+    gb::NormalFormCache<ModInt> cache;
+    auto expected = BuildCyclic(4);
+    expected.BuildGreobnerBasis();
+
+    auto first = BuildCyclic(4);
+    first.SetNormalFormCache(&cache);
+    first.BuildGreobnerBasis();
+    EXPECT_EQ(first, expected);
+    EXPECT_GT(cache.Size(), 0);
+    size_t misses = cache.Misses();
+
+    // the second run takes every remainder from the cache
+    auto second = BuildCyclic(4);
+    second.SetNormalFormCache(&cache);
+    second.BuildGreobnerBasis();
+    EXPECT_EQ(second, expected);
+    EXPECT_EQ(cache.Misses(), misses);
+
+    auto f = gb::Polynom<ModInt>::BuildFromString("x^3y+2xyz+z^2+1");
+    auto g = gb::Polynom<ModInt>::BuildFromString("x^2+y");
+    size_t hits = cache.Hits();
+    EXPECT_EQ(second.Reduce(f), expected.Reduce(f));
+    EXPECT_EQ(second.Reduce(f), expected.Reduce(f));
+    EXPECT_EQ(second.Reduce(g), expected.Reduce(g));
+    EXPECT_EQ(second.Reduce(g), expected.Reduce(g));
+    EXPECT_EQ(cache.Hits(), hits + 2);
+}
+
+// The fingerprints of {x - 1} and {x - 2} differ only in the coefficients
+template <typename Field>
+void CheckCoefficientsInFingerprint() {
+    gb::NormalFormCache<Field> cache;
+    auto x = gb::Polynom<Field>::BuildFromString("x");
+    for (int64_t root : {1, 2, 1}) {
+        gb::PolynomialsSet<Field> set = {x - gb::Polynom<Field>(gb::Term<Field>(Field(root)))};
+        set.SetNormalFormCache(&cache);
+        EXPECT_EQ(set.Reduce(x), gb::Polynom<Field>(gb::Term<Field>(Field(root))));
+    }
+    EXPECT_EQ(cache.Hits(), 1);
+}
+
+TEST(CacheTest, CoefficientsInFingerprint) {
+    CheckCoefficientsInFingerprint<ModInt>();
+    CheckCoefficientsInFingerprint<Fraction>();
+    CheckCoefficientsInFingerprint<gb::Rational>();
+}
+
+TEST(CacheTest, Fingerprint) {
+    // a set with the same elements in the same order, built by Add alone
+    auto rebuilt = [](const gb::PolynomialsSet<ModInt>& set) {
+        gb::PolynomialsSet<ModInt> result;
+        for (const auto& f : set) {
+            result.Add(f);
+        }
+        return result;
+    };
+
+    auto set = BuildCyclic(4);
+    EXPECT_EQ(set.Fingerprint(), rebuilt(set).Fingerprint());
+    set.Erase(set.begin() + 1);
+    EXPECT_EQ(set.Fingerprint(), rebuilt(set).Fingerprint());
+    set.Add(gb::Polynom<ModInt>::BuildFromString("x^2+y"));
+    EXPECT_EQ(set.Fingerprint(), rebuilt(set).Fingerprint());
+    *set.begin() = gb::Polynom<ModInt>::BuildFromString("z^3+1");
+    EXPECT_EQ(set.Fingerprint(), rebuilt(set).Fingerprint());
+    set.BuildGreobnerBasis();
+    EXPECT_EQ(set.Fingerprint(), rebuilt(set).Fingerprint());
+    set.AutoReduction();
+    EXPECT_EQ(set.Fingerprint(), rebuilt(set).Fingerprint());
+
+    EXPECT_NE(set.Fingerprint(), BuildCyclic(4).Fingerprint());
+    using LexSet = gb::PolynomialsSet<ModInt, gb::LexOrder>;
+    EXPECT_NE(gb::PolynomialsSet<ModInt>().Fingerprint(), LexSet().Fingerprint());
+}
+
+TEST(CacheTest, BoundedAndConcurrent) {
+    gb::NormalFormCache<ModInt> small(32);
+    auto basis = BuildCyclic(4);
+    basis.BuildGreobnerBasis();
+    basis.SetNormalFormCache(&small);
+
+    std::mt19937 rng(38);
+    std::vector<gb::Polynom<ModInt>> polynoms;
+    for (size_t i = 0; i < 200; ++i) {
+        gb::Polynom<ModInt>::Builder poly;
+        for (size_t k = 0; k < 4; ++k) {
+            std::vector<gb::Monom::Degree> degrees(3);
+            for (auto& degree : degrees) {
+                degree = rng() % 3;
+            }
+            poly.AddTerm(static_cast<int64_t>(rng() % 1000) + 1,
+                         gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        polynoms.push_back(poly.BuildPolynom());
+    }
+
+    for (const auto& f : polynoms) {
+        basis.Reduce(f);
+    }
+    EXPECT_LE(small.Size(), 32);
+
+    gb::NormalFormCache<ModInt> shared;
+    basis.SetNormalFormCache(&shared);
+    auto uncached = basis;
+    uncached.SetNormalFormCache(nullptr);
+
+    gb::ThreadPool pool(4);
+    std::vector<int> matches(polynoms.size() * 2);
+    pool.ParallelFor(matches.size(), [&](size_t i, size_t) {
+        const auto& f = polynoms[i % polynoms.size()];
+        matches[i] = basis.Reduce(f) == uncached.Reduce(f);
+    });
+    EXPECT_EQ(std::count(matches.begin(), matches.end(), 1), matches.size());
+    EXPECT_EQ(shared.Hits() + shared.Misses(), matches.size());
+}
+
+using TrackedSet = gb::PolynomialsSet<ModInt, gb::GrevLexOrder, gb::TrackCofactors>;
+
+gb::Polynom<ModInt> Combine(const std::vector<gb::Polynom<ModInt>>& cofactors,
+                            const std::vector<gb::Polynom<ModInt>>& generators) {
+    EXPECT_EQ(cofactors.size(), generators.size());
+    gb::Polynom<ModInt> sum;
+    for (size_t k = 0; k < cofactors.size(); ++k) {
+        sum = sum + cofactors[k] * generators[k];
+    }
+    return sum;
+}
+
+TEST(CofactorsTest, ExpressBasisByGenerators) {
+    for (auto mode : {gb::ReductionMode::kTop, gb::ReductionMode::kFull}) {
+        auto expected = BuildCyclic(4);
+        expected.BuildGreobnerBasis();
+
+        TrackedSet tracked;
+        tracked.SetReductionMode(mode);
+        for (const auto& f : BuildCyclic(4)) {
+            tracked.Add(f * ModInt(3));
+        }
+        tracked.BuildGreobnerBasis();
+        ASSERT_EQ(tracked.Size(), expected.Size());
+        EXPECT_TRUE(std::equal(tracked.begin(), tracked.end(), expected.begin()));
+        EXPECT_EQ(tracked.GetCofactorStats().expanded, 0);
+
+        for (const auto& g : tracked) {
+            EXPECT_EQ(Combine(tracked.Cofactors(g), tracked.Generators()), g);
+        }
+
+        auto stats = tracked.GetCofactorStats();
+        EXPECT_EQ(stats.generators, 4);
+        EXPECT_GT(stats.records, tracked.Size());
+        EXPECT_GT(stats.expanded, 0);
+        EXPECT_GT(stats.memory_bytes, 0);
+
+        auto member = gb::Polynom<ModInt>::BuildFromString("x^2y+z") * *tracked.begin();
+        auto other = gb::Polynom<ModInt>::BuildFromString("x^3y+2xyz+z^2+1");
+        for (const auto& f : {member, member + other}) {
+            std::vector<gb::Polynom<ModInt>> cofactors;
+            auto remainder = tracked.ReduceWithCofactors(f, cofactors);
+            EXPECT_EQ(remainder, expected.Reduce(f).value_or(f));
+            EXPECT_EQ(remainder + Combine(cofactors, tracked.Generators()), f);
+        }
+    }
+}
+
+TEST(CofactorsTest, AutoReduction) {
+    TrackedSet tracked = {gb::Polynom<ModInt>::BuildFromString("2x^2y+3"),
+                          gb::Polynom<ModInt>::BuildFromString("xy^2+x+1"),
+                          gb::Polynom<ModInt>::BuildFromString("x^2y^2+y")};
+    tracked.AutoReduction();
+    EXPECT_EQ(tracked.Size(), 3);
+    for (const auto& g : tracked) {
+        EXPECT_EQ(Combine(tracked.Cofactors(g), tracked.Generators()), g);
+    }
+
+    gb::GroebnerTrace trace;
+    gb::ComputationContext context;
+    tracked.BuildGreobnerBasis(context, trace);
+    EXPECT_FALSE(trace.IsEmpty());
+    for (const auto& g : tracked) {
+        EXPECT_EQ(Combine(tracked.Cofactors(g), tracked.Generators()), g);
+    }
+}
+
+TEST(BatchTest, MatchesSequential) {
+    // seeded random binomial ideals and a few cyclic ones
+    std::mt19937 rng(40);
+    std::vector<gb::PolynomialsSet<ModInt>> ideals, expected;
+    for (size_t i = 0; i < 100; ++i) {
+        gb::PolynomialsSet<ModInt> ideal;
+        for (size_t k = 0; k < 3; ++k) {
+            ideal.Add(RandomPolynom(rng, 3, 2, 6));
+        }
+        ideals.push_back(ideal);
+    }
+    for (size_t n = 2; n <= 5; ++n) {
+        ideals.push_back(BuildCyclic(n));
+    }
+    for (auto ideal : ideals) {
+        ideal.BuildGreobnerBasis();
+        expected.push_back(ideal);
+    }
+
+    gb::ThreadPool pool(4);
+    gb::BatchSolver<ModInt> solver(pool, 64);
+
+    size_t next = 0, expected_index = 0;
+    size_t count = solver.Solve(
+        [&]() -> std::optional<gb::PolynomialsSet<ModInt>> {
+            if (next == ideals.size()) {
+                return std::nullopt;
+            }
+            return ideals[next++];
+        },
+        [&](size_t index, gb::PolynomialsSet<ModInt>&& basis) {
+            EXPECT_EQ(index, expected_index++);
+            EXPECT_EQ(basis, expected[index]);
+        });
+    EXPECT_EQ(count, ideals.size());
+    EXPECT_EQ(expected_index, ideals.size());
+
+    solver.Solve(ideals);
+    EXPECT_EQ(ideals, expected);
+
+    std::vector<gb::PolynomialsSet<ModInt>> empty;
+    solver.Solve(empty);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(BatchTest, WorkStealingVisitsEveryIndex) {
+    for (size_t count : {0, 1, 7, 1000}) {
+        gb::WorkStealingRanges ranges(count, 3);
+        std::vector<int> visits(count);
+        std::vector<size_t> lanes = {2, 2, 2, 0, 1};  // lane 2 steals from the others
+        for (size_t step = 0;; ++step) {
+            auto index = ranges.Next(lanes[step % lanes.size()]);
+            if (!index) {
+                break;
+            }
+            ++visits[index.value()];
+        }
+        EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), count);
+    }
+}
+
+// Every polynomial times powers of the new variable h to the degree of its leading term
+gb::PolynomialsSet<ModInt> Homogenize(const gb::PolynomialsSet<ModInt>& set, size_t h) {
+    gb::PolynomialsSet<ModInt> result;
+    for (const auto& f : set) {
+        gb::Polynom<ModInt>::Builder poly;
+        for (const auto& t : f) {
+            std::vector<gb::Monom::Degree> degrees(h + 1, 0);
+            degrees[h] = f.GetLargestTerm().TotalDegree() - t.TotalDegree();
+            poly.AddTerm(t.GetCoefficient(),
+                         t.GetMonom() * gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        result.Add(poly.BuildPolynom());
+    }
+    return result;
+}
+
+TEST(StreamTest, DegreeByDegree) {
+    auto homogeneous = Homogenize(BuildCyclic(4), 4);
+    auto expected = homogeneous;
+    expected.BuildGreobnerBasis();
+
+    gb::GroebnerBasisStream<ModInt> stream(homogeneous);
+    EXPECT_TRUE(stream.IsIncremental());
+
+    gb::PolynomialsSet<ModInt> streamed;
+    size_t degree = 0;
+    for (const auto& g : stream) {
+        EXPECT_GE(g.GetLargestTerm().TotalDegree(), degree);
+        degree = g.GetLargestTerm().TotalDegree();
+        streamed.Add(g);
+    }
+    std::sort(streamed.begin(), streamed.end());
+    EXPECT_EQ(streamed, expected);
+    EXPECT_FALSE(stream.Next());
+
+    // a cancelled stream resumes where it stopped
+    gb::GroebnerBasisStream<ModInt> resumed(homogeneous);
+    gb::CancellationToken token;
+    gb::ComputationContext cancelled;
+    cancelled.SetCancellationToken(token);
+    token.Cancel();
+    EXPECT_FALSE(resumed.Next(cancelled));
+    gb::PolynomialsSet<ModInt> all;
+    for (const auto& g : resumed) {
+        all.Add(g);
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(all, expected);
+}
+
+TEST(StreamTest, FallsBackToFullBuild) {
+    auto cyclic = BuildCyclic(4);
+    auto expected = cyclic;
+    expected.BuildGreobnerBasis();
+
+    gb::GroebnerBasisStream<ModInt> stream(cyclic);
+    EXPECT_FALSE(stream.IsIncremental());
+    gb::PolynomialsSet<ModInt> streamed;
+    while (auto g = stream.Next()) {
+        streamed.Add(g.value());
+    }
+    EXPECT_EQ(streamed, expected);
+
+    gb::PolynomialsSet<ModInt, gb::LexOrder> lex;
+    for (const auto& f : Homogenize(BuildCyclic(3), 3)) {
+        lex.Add(gb::ChangeOrder(f, gb::LexOrder()));
+    }
+    gb::GroebnerBasisStream<ModInt, gb::LexOrder> lex_stream(lex);
+    EXPECT_FALSE(lex_stream.IsIncremental());
+    lex.BuildGreobnerBasis();
+    EXPECT_EQ(std::distance(lex.begin(), lex.end()),
+              std::ranges::distance(lex_stream.begin(), lex_stream.end()));
+}
+
+// Every product of two terms added separately, then sorted at once
+template <typename Order>
+gb::Polynom<ModInt, Order> NaiveProduct(const gb::Polynom<ModInt, Order>& f,
+                                        const gb::Polynom<ModInt, Order>& g) {
+    typename gb::Polynom<ModInt, Order>::Builder product(f.GetOrder());
+    for (const auto& a : f) {
+        for (const auto& b : g) {
+            product.AddTerm(a * b);
+        }
+    }
+    return product.BuildPolynom();
+}
+
+TEST(PolynomTest, HeapAndParallelProducts) {
+    std::mt19937 rng(42);
+    auto random = [&](size_t terms, const auto& order) {
+        typename gb::Polynom<ModInt, std::decay_t<decltype(order)>>::Builder poly(order);
+        for (size_t k = 0; k < terms; ++k) {
+            std::vector<gb::Monom::Degree> degrees(3);
+            for (auto& degree : degrees) {
+                degree = rng() % 7;
+            }
+            poly.AddTerm(static_cast<int64_t>(rng() % 5) - 2,
+                         gb::Monom::BuildFromVectorDegrees(degrees));
+        }
+        return poly.BuildPolynom();
+    };
+
+    gb::ThreadPool pool(3);
+    for (size_t n : {0, 1, 20, 60, 300}) {
+        for (size_t m : {1, 40, 300}) {
+            auto f = random(n, gb::GrevLexOrder());
+            auto g = random(m, gb::GrevLexOrder());
+            auto expected = NaiveProduct(f, g);
+            EXPECT_EQ(f * g, expected);
+            EXPECT_EQ(g * f, expected);
+            EXPECT_EQ(Multiply(f, g, pool), expected);
+
+            gb::WeightedOrder weighted({3, 1, 2});
+            auto fw = random(n, weighted);
+            auto gw = random(m, weighted);
+            EXPECT_EQ(Multiply(fw, gw, pool), NaiveProduct(fw, gw));
+        }
+    }
+
+    // like terms of different chunks cancel in the final merge
+    auto f = random(300, gb::GrevLexOrder());
+    auto g = random(300, gb::GrevLexOrder());
+    EXPECT_TRUE(Multiply(f, g, pool) - Multiply(g, f, pool) == gb::Polynom<ModInt>());
+
+    // the terms of a matrix order carry their keys through sums and products
+    gb::WeightedOrder weighted({3, 1, 2});
+    auto fw = random(300, weighted);
+    auto gw = random(300, weighted);
+    EXPECT_TRUE((Multiply(fw, gw, pool) - gw * fw).IsZero());
+    EXPECT_EQ(fw + gw - gw, fw);
+}
+
+// Random ideals of every special shape, built with and without the fast paths
+template <typename Order>
+void CheckFastPaths(const Order& order, std::mt19937& rng) {
+    auto random = [&](size_t terms, auto degrees) {
+        typename gb::Polynom<ModInt, Order>::Builder poly(order);
+        for (size_t k = 0; k < terms; ++k) {
+            poly.AddTerm(static_cast<int64_t>(rng() % 7) - 3,
+                         gb::Monom::BuildFromVectorDegrees(degrees()));
+        }
+        return poly.BuildPolynom();
+    };
+    auto linear = [&] {
+        std::vector<gb::Monom::Degree> degrees(4);
+        size_t variable = rng() % 5;
+        if (variable < 4) {
+            degrees[variable] = 1;
+        }
+        return degrees;
+    };
+    auto univariate = [&] {
+        return std::vector<gb::Monom::Degree>{0, static_cast<gb::Monom::Degree>(rng() % 6)};
+    };
+    auto binomial = [&] {
+        return std::vector<gb::Monom::Degree>{static_cast<gb::Monom::Degree>(rng() % 4),
+                                              static_cast<gb::Monom::Degree>(rng() % 4),
+                                              static_cast<gb::Monom::Degree>(rng() % 4)};
+    };
+
+    for (size_t iteration = 0; iteration < 30; ++iteration) {
+        gb::PolynomialsSet<ModInt, Order> sets[3] = {gb::PolynomialsSet<ModInt, Order>(order),
+                                                     gb::PolynomialsSet<ModInt, Order>(order),
+                                                     gb::PolynomialsSet<ModInt, Order>(order)};
+        for (size_t k = 0, count = 1 + rng() % 5; k < count; ++k) {
+            sets[0].Add(random(1 + rng() % 5, linear));
+        }
+        // a common factor keeps some of the greatest common divisors nontrivial
+        auto factor = random(2, univariate);
+        for (size_t k = 0, count = 1 + rng() % 3; k < count; ++k) {
+            sets[1].Add(random(1 + rng() % 3, univariate) * factor);
+        }
+        for (size_t k = 0, count = 1 + rng() % 4; k < count; ++k) {
+            sets[2].Add(random(2, binomial));
+        }
+
+        for (auto& set : sets) {
+            auto generic = set;
+            generic.SetFastPaths(false);
+            generic.BuildGreobnerBasis();
+            set.BuildGreobnerBasis();
+            EXPECT_EQ(set, generic);
+        }
+    }
+}
+
+TEST(FastPathsTest, MatchGenericBuild) {
+    std::mt19937 rng(7);
+    CheckFastPaths(gb::GrevLexOrder(), rng);
+    CheckFastPaths(gb::LexOrder(), rng);
+    CheckFastPaths(gb::WeightedOrder({2, 1, 3, 1}), rng);
+}
+
+TEST(FastPathsTest, DetectShape) {
+    using Polynoms = std::vector<gb::Polynom<ModInt>>;
+    auto parse = [](std::initializer_list<std::string> polys) {
+        Polynoms result;
+        for (const auto& poly : polys) {
+            result.push_back(gb::Polynom<ModInt>::BuildFromString(poly));
+        }
+        return result;
+    };
+
+    EXPECT_EQ(gb::DetectShape(parse({"2x+3y+4z+5", "y+1"})), gb::IdealShape::kLinear);
+    EXPECT_EQ(gb::DetectShape(parse({"y^3+2y+1", "y^2+4"})), gb::IdealShape::kUnivariate);
+    EXPECT_EQ(gb::DetectShape(parse({"x^2y+3z^2", "xz"})), gb::IdealShape::kBinomial);
+    EXPECT_EQ(gb::DetectShape(parse({"x^2+y+1", "xz"})), gb::IdealShape::kGeneral);
+    EXPECT_EQ(gb::DetectShape(parse({"x^2+1", "y^2+1"})), gb::IdealShape::kBinomial);
+
+    // an inconsistent linear system and coprime polynomials generate the whole ring
+    auto one = gb::PolynomialsSet<ModInt>{gb::Polynom<ModInt>::BuildFromString("1")};
+    EXPECT_EQ(BuildFromStrings({"x+y+1", "x+y+2", "x+z"}), one);
+    EXPECT_EQ(BuildFromStrings({"z^2+1", "z^3+z+1"}), one);
+}
+
+TEST(RationalTest, IntegerArithmetic) {
+    using Big = gb::Integer::Big;
+    std::mt19937_64 rng(44);
+    auto random = [&] {
+        // every magnitude from a few bits to the whole int64_t range
+        int64_t value = static_cast<int64_t>(rng() >> (rng() % 64));
+        return rng() % 2 ? value : -value;
+    };
+    auto check = [](const gb::Integer& value, const Big& expected) {
+        EXPECT_EQ(value.ToBig(), expected);
+        EXPECT_EQ(value.IsSmall(), expected >= std::numeric_limits<int64_t>::min() &&
+                                       expected <= std::numeric_limits<int64_t>::max());
+    };
+
+    for (size_t iteration = 0; iteration < 10000; ++iteration) {
+        int64_t a = random(), b = random();
+        gb::Integer x = a, y = b;
+        check(x + y, Big(a) + Big(b));
+        check(x - y, Big(a) - Big(b));
+        check(x * y, Big(a) * Big(b));
+        check((x * y) * (x - y), Big(a) * Big(b) * (Big(a) - Big(b)));
+        check((x * y + 1) - x * y, 1);
+        check(-x, -Big(a));
+        if (b != 0) {
+            check(x / y, Big(a) / Big(b));
+            check(x % y, Big(a) % Big(b));
+            check((x * y) / y, a);
+        }
+        check(Gcd(x * y, y * y), boost::multiprecision::gcd(Big(a) * Big(b), Big(b) * Big(b)));
+        EXPECT_EQ(x * y < y * y, Big(a) * Big(b) < Big(b) * Big(b));
+        EXPECT_EQ(x * y == y * x, true);
+    }
+
+    gb::Integer min = std::numeric_limits<int64_t>::min();
+    check(-min, -Big(std::numeric_limits<int64_t>::min()));
+    check(min / -1, -Big(std::numeric_limits<int64_t>::min()));
+    check(Gcd(min, 0), -Big(std::numeric_limits<int64_t>::min()));
+}
+
+TEST(RationalTest, MatchesFraction) {
+    std::mt19937 rng(45);
+    auto check = [](const gb::Rational& value, const Fraction& expected) {
+        EXPECT_EQ(value.Numerator(), gb::Integer(expected.numerator()));
+        EXPECT_EQ(value.Denominator(), gb::Integer(expected.denominator()));
+    };
+
+    for (size_t iteration = 0; iteration < 10000; ++iteration) {
+        int64_t values[4];
+        for (auto& value : values) {
+            value = static_cast<int64_t>(rng() % 2001) - 1000;
+        }
+        values[1] = values[1] ? values[1] : 1;
+        values[3] = values[3] ? values[3] : 1;
+        gb::Rational x(values[0], values[1]), y(values[2], values[3]);
+        Fraction a(values[0], values[1]), b(values[2], values[3]);
+
+        check(x, a);
+        check(x + y, a + b);
+        check(x - y, a - b);
+        check(x * y, a * b);
+        if (values[2]) {
+            check(x / y, a / b);
+        }
+        EXPECT_EQ(x < y, a < b);
+        EXPECT_EQ(x == y, a == b);
+    }
+
+    std::stringstream stream("-6/4 7");
+    gb::Rational x, y;
+    stream >> x >> y;
+    check(x, Fraction(-3, 2));
+    check(y, Fraction(7));
+}
+
+// The reduced basis over Q of generators with large integer coefficients, mapped to the
+// prime field, is the basis of the mapped generators unless the prime divides a denominator
+TEST(RationalTest, ExactBasisOverQ) {
+    std::mt19937_64 rng(46);
+    auto to_modulus = [](const gb::Rational& c) {
+        constexpr int64_t kPrime = ModInt::kModulus;
+        auto residue = [](const gb::Integer& value) {
+            return ModInt(static_cast<int64_t>((value % kPrime).ToBig()));
+        };
+        return residue(c.Numerator()) / residue(c.Denominator());
+    };
+
+    for (size_t iteration = 0; iteration < 20; ++iteration) {
+        gb::PolynomialsSet<gb::Rational> exact;
+        gb::PolynomialsSet<ModInt> modular;
+        for (size_t k = 0; k < 3; ++k) {
+            gb::Polynom<gb::Rational>::Builder poly;
+            gb::Polynom<ModInt>::Builder mapped;
+            for (size_t t = 0; t < 3; ++t) {
+                std::vector<gb::Monom::Degree> degrees = {
+                    static_cast<gb::Monom::Degree>(rng() % 3),
+                    static_cast<gb::Monom::Degree>(rng() % 3),
+                    static_cast<gb::Monom::Degree>(rng() % 2)};
+                auto monom = gb::Monom::BuildFromVectorDegrees(degrees);
+                gb::Rational c = gb::Integer(static_cast<int64_t>(rng() % (1ll << 40)) + 1);
+                poly.AddTerm(c, monom);
+                mapped.AddTerm(to_modulus(c), monom);
+            }
+            exact.Add(poly.BuildPolynom());
+            modular.Add(mapped.BuildPolynom());
+        }
+
+        exact.BuildGreobnerBasis();
+        modular.BuildGreobnerBasis();
+
+        gb::PolynomialsSet<ModInt> reduced;
+        for (const auto& f : exact) {
+            EXPECT_EQ(f.GetLargestTerm().GetCoefficient(), gb::Rational(1));
+            gb::Polynom<ModInt>::Builder mapped;
+            for (const auto& t : f) {
+                mapped.AddTerm(to_modulus(t.GetCoefficient()), t.GetMonom());
+            }
+            reduced.Add(mapped.BuildPolynom());
+        }
+        std::sort(reduced.begin(), reduced.end());
+        EXPECT_EQ(reduced, modular);
+
+        // Add keeps its elements monic over fractions too
+        gb::PolynomialsSet<gb::Rational> collected;
+        for (const auto& f : exact) {
+            auto scaled = f;
+            scaled.Scale(gb::Rational(3));
+            collected.Add(scaled);
+        }
+        EXPECT_EQ(collected, exact);
+    }
+}
+
 int main() {
     ::testing::InitGoogleTest();
     return RUN_ALL_TESTS();
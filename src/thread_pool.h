@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace groebner_basis {
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads_count = std::thread::hardware_concurrency()) {
+
+        threads_count = std::max<size_t>(threads_count, 1);
+        workers_.reserve(threads_count);
+        for (size_t worker = 0; worker < threads_count; ++worker) {
+            workers_.emplace_back([this, worker] { WorkerLoop(worker); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    size_t Size() const {
+        return workers_.size();
+    }
+
+    // Calls function(index, worker) for every index in [0, count) and waits for all of them.
+    // worker is in [0, Size()) and can be used to address per-worker scratch memory.
+    // Must not be called from inside a task of the same pool.
+    template <typename Function>
+    void ParallelFor(size_t count, Function&& function) {
+
+        if (count == 0) {
+            return;
+        }
+
+        size_t tasks_count = std::min(count, Size());
+        std::atomic<size_t> next_index = 0;
+        std::latch done(tasks_count);
+
+        for (size_t i = 0; i < tasks_count; ++i) {
+            Submit([&](size_t worker) {
+                for (size_t index = next_index++; index < count; index = next_index++) {
+                    function(index, worker);
+                }
+                done.count_down();
+            });
+        }
+
+        done.wait();
+    }
+
+private:
+    void Submit(std::function<void(size_t)> task) {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    void WorkerLoop(size_t worker) {
+
+        while (true) {
+            std::function<void(size_t)> task;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task(worker);
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void(size_t)>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+}  // namespace groebner_basis
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "monom.h"
+
+namespace groebner_basis {
+
+// What the Buchberger driver did in one successful run, recorded by
+// PolynomialsSet::BuildGreobnerBasis(context, trace). A later run on polynomials with the same
+// supports (other coefficients, another prime) replays it with ReplayGroebnerBasis: the pairs
+// that reduced to zero are skipped and every reduction step uses the recorded reducer.
+struct GroebnerTrace {
+    // the leading monomial of the polynomial being reduced and the element that reduces it
+    struct Step {
+        Monom leading;
+        uint32_t reducer = 0;
+    };
+
+    // a pair (i, j) with a nonzero remainder, which became a new element of the set
+    struct Pair {
+        uint32_t i = 0;
+        uint32_t j = 0;
+        std::vector<Step> steps;
+        Monom result;  // the leading monomial of the remainder
+    };
+
+    bool IsEmpty() const {
+        return input.empty();
+    }
+
+    void Clear() {
+        input.clear();
+        pairs.clear();
+        survivors.clear();
+    }
+
+    std::vector<std::vector<Monom>> input;  // supports of the input polynomials
+    std::vector<Pair> pairs;                // in the order in which they were processed
+    std::vector<uint32_t> survivors;        // the elements kept by Minimize
+};
+
+}  // namespace groebner_basis
@@ -1,5 +1,8 @@
+#pragma once
 
 #include <cassert>
+#include <functional>
+#include <string>
 
 namespace groebner_basis {
 
@@ -20,11 +23,17 @@ template <typename T, T Tmod>
     requires IsPrimeV<T, Tmod>
 class Modulus {
 public:
+    static constexpr T kModulus = Tmod;
+
     Modulus() = default;
 
     Modulus(T value) : value_(Mod(value)) {
     }
 
+    T GetValue() const {
+        return value_;
+    }
+
     Modulus operator-() const {
         return Modulus(Tmod - value_);
     }
@@ -91,6 +100,14 @@ public:
         return stream;
     }
 
+    template <typename Stream>
+    friend Stream& operator>>(Stream& stream, Modulus& modulus) {
+        T value;
+        stream >> value;
+        modulus = Modulus(value);
+        return stream;
+    }
+
 private:
     static T Mod(T value) {
         value %= Tmod;
@@ -119,4 +136,28 @@ private:
 
     T value_ = 0;
 };
+
+// Name of a coefficient type or a monomial order for checkpoints and fingerprints, unlike
+// typeid names it is the same for every compiler. Types with a static kName use it, the
+// others specialize TypeName.
+template <typename T>
+struct TypeName {
+    static std::string Get() {
+        return T::kName;
+    }
+};
+
+template <typename T, T Tmod>
+struct TypeName<Modulus<T, Tmod>> {
+    static std::string Get() {
+        return "modulus " + std::to_string(Tmod);
+    }
+};
 }  // namespace groebner_basis
+
+template <typename T, T Tmod>
+struct std::hash<groebner_basis::Modulus<T, Tmod>> {
+    size_t operator()(groebner_basis::Modulus<T, Tmod> value) const {
+        return std::hash<T>()(value.GetValue());
+    }
+};